@@ -8,6 +8,39 @@
 
 
 
+	v0.33	2026Oct16 stats, schedules and the response ring are caller-owned, attached with stats_attach(), schedule_attach()
+			and response_ring_set(); one built-in response slot
+	v0.32	2026Oct16 LCM300_INSTRUMENTATION 0 empties the timing hooks in the .cpp only; stats stays, so the class layout doesn't depend on it
+	v0.31	2026Oct16 energy_update (meter, frame, ms, pout): gap estimate from the Pout given, not this supply's snapshot
+	v0.30	2026Oct16 milli_shift(): no left shift of a negative value
+	v0.29	2026Oct16 identity_invalidate() forgets learned block read lengths
+	v0.28	2026Oct16 probe() that finds nothing starts the background re-probe backoff
+	v0.27	2026Oct16 stats utilization over a 64-bit elapsed time; no timing calls while stats are disabled
+	v0.26	2026Oct16 command_start_into (cmd_idx, dest) instead of an ambiguous command_start() overload
+	v0.25	2026Oct16 energy_update (meter, frame, ms): captured frames go into a caller's meter, not energy
+	v0.24	2026Oct16 PEC failures tallied in error as LCM300_RD_INVALID
+	v0.23	2026Oct16 short reads and bad block lengths tallied in error as LCM300_RD_INVALID
+	v0.22	2026Oct16 probe(): address-only presence check for discovery
+	v0.21	2026Oct16 bus I/O through a shared Systronix_LCM300_transport instead of a per-instance i2c_t3 copy
+	v0.20	2026Oct16 cmd[] one constexpr table for all instances; typed read<CMD_IDX>()
+	v0.19	2026Oct16 retry, backoff, stuck bus reset, and re-probe of absent supplies for queued commands
+	v0.18	2026Oct16 transaction instrumentation: per-command counts, bytes, latency; histogram; utilization
+	v0.17	2026Oct16 write path: VOUT_COMMAND, OPERATION, WRITE_PROTECT setters with read-back verify
+	v0.16	2026Oct16 adaptive scheduler: schedule_set() per-command periods, priorities and deadlines
+	v0.15	2026Oct16 fault monitor: STATUS_WORD polling, detail reads on change, fault callback and auto clear
+	v0.14	2026Oct16 response_t.us: micros() completion time, for the binary log
+	v0.13	2026Oct16 command_start() responses in a ring or caller-supplied buffer instead of cmd_response
+	v0.12	2026Oct16 eout_average_power() / eout_parse() for captured READ_EOUT frames; no pointer casts
+	v0.11	2026Oct16 energy_update(): 64-bit READ_EOUT energy meter with counter unwrapping; energy_save() / restore()
+	v0.10	2026Oct16 decode_linear11() / decode_linear16() for arrays of raw words
+	v0.9	2026Oct16 linear decode by table lookup instead of powf(); raw_voltage_to_milli(), pmbus_literal_to_milli()
+	v0.8	2026Oct16 optional PMBus packet error checking: pec_set(), table-driven CRC-8
+	v0.7	2026Oct16 block reads of the length the supply returned; length byte checked, errors in pmbus_error
+	v0.6	2026Oct16 identity and limits cache read once by init(); identity_get(), identity_refresh()
+	v0.5	2026Oct16 telemetry snapshot: poll_telemetry() sweep into a timestamped struct; snapshot()
+	v0.4	2026Oct16 command queue: command_queue() / command_dequeue() for Systronix_LCM300_bus
+	v0.3	2026Oct16 non-blocking command_start() / command_poll(); communication interval timed from the
+			last transaction instead of a fixed delay before every transaction
 	v0.2	2018Mar22 bboyes finishing up thanks to some tech support from Artesyn
     v0.1	2016Dec01 bboyes Start based on LCM300Q library
 
@@ -73,7 +106,41 @@ Therefore the possible address range is the eight 7-bit addresses 0x5[8..F]
 
 -------- PMBus Reads --------
 
+The LCM300 needs a quiet interval between transactions (LCM300_CMD_INTERVAL_US, 50 ms). This used to be
+a delay(50) ahead of every transaction; now the time of the end of the last transaction to each supply
+is kept and only the remainder of the interval is waited out, if any.
 
+command_read() blocks until the response is in hand. command_start() and command_poll() do the same
+transaction without blocking: command_start() accepts the command and command_poll(), called from loop(),
+steps through the interval wait, the command byte write, and the repeated-start read using the i2c_t3
+non-blocking sendTransmission() / sendRequest() calls. command_poll() returns LCM300_PENDING until the
+transaction is complete, then SUCCESS or FAIL.
+
+command_read() leaves its response in cmd_response. Reads begun with command_start() leave theirs in a
+response_t with the command index and completion time: one supplied by the caller, or the next of a ring
+the sketch gives the instance with response_ring_set() (one built-in slot without). So an async read, or a
+bus sweep, never overwrites a response that some other part of the sketch is still decoding;
+response_last() and response_find() get them back.
+
+The optional bookkeeping that costs the most RAM lives in the sketch, not in each instance: the response
+ring, the adaptive schedules (schedule_attach()) and the transaction stats (stats_attach()). A supply that
+doesn't use them pays a pointer for each.
+
+The ascii commands and READ_EOUT are PMBus block reads: the first byte is the number of bytes that
+follow. The i2c_t3 read length is fixed when the read is requested, so the first read of a block command
+asks for the most the command can return (ASCII, 17 bytes) and the length byte received then sets the
+length of later reads of that command: MFR_REVISION costs 3 bytes on the bus instead of 17. A length byte
+larger than the command allows, or larger than what was received, fails the read (counted in
+pmbus_error.block_length_count) and the next read of that command is full length again.
+
+
+-------- Packet Error Checking --------
+
+PMBus optionally appends a packet error check (PEC) byte to every transaction: a CRC-8 (polynomial
+x^8 + x^2 + x + 1, initial value 0) of every byte of the transaction including the address bytes. With
+pec_set(true), reads request one extra byte and fail with pmbus_error.pec_count incremented when it
+doesn't match; writes append it. The CRC is computed with a 256-byte table (in flash) so checking costs a
+table lookup and an xor per byte. Off by default.
 
 -------- PMBus Writes --------
 
@@ -85,6 +152,56 @@ you can change their contents.
 #include <Systronix_LCM300.h>
 
 
+//---------------------------< C M D >------------------------------------------------------------------------
+//
+// Storage for the one cmd[] table all instances share; its entries are in the class declaration
+//
+
+constexpr Systronix_LCM300::cmd_t Systronix_LCM300::cmd[CMD_ARRAY_SIZE];
+
+
+//---------------------------< P E C _ T A B L E >------------------------------------------------------------
+//
+// CRC-8 of each byte value for polynomial 0x07; see pec_crc8()
+//
+
+static const uint8_t pec_table[256] =
+	{
+	0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+	0x70, 0x77, 0x7E, 0x79, 0x6C, 0x6B, 0x62, 0x65, 0x48, 0x4F, 0x46, 0x41, 0x54, 0x53, 0x5A, 0x5D,
+	0xE0, 0xE7, 0xEE, 0xE9, 0xFC, 0xFB, 0xF2, 0xF5, 0xD8, 0xDF, 0xD6, 0xD1, 0xC4, 0xC3, 0xCA, 0xCD,
+	0x90, 0x97, 0x9E, 0x99, 0x8C, 0x8B, 0x82, 0x85, 0xA8, 0xAF, 0xA6, 0xA1, 0xB4, 0xB3, 0xBA, 0xBD,
+	0xC7, 0xC0, 0xC9, 0xCE, 0xDB, 0xDC, 0xD5, 0xD2, 0xFF, 0xF8, 0xF1, 0xF6, 0xE3, 0xE4, 0xED, 0xEA,
+	0xB7, 0xB0, 0xB9, 0xBE, 0xAB, 0xAC, 0xA5, 0xA2, 0x8F, 0x88, 0x81, 0x86, 0x93, 0x94, 0x9D, 0x9A,
+	0x27, 0x20, 0x29, 0x2E, 0x3B, 0x3C, 0x35, 0x32, 0x1F, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0D, 0x0A,
+	0x57, 0x50, 0x59, 0x5E, 0x4B, 0x4C, 0x45, 0x42, 0x6F, 0x68, 0x61, 0x66, 0x73, 0x74, 0x7D, 0x7A,
+	0x89, 0x8E, 0x87, 0x80, 0x95, 0x92, 0x9B, 0x9C, 0xB1, 0xB6, 0xBF, 0xB8, 0xAD, 0xAA, 0xA3, 0xA4,
+	0xF9, 0xFE, 0xF7, 0xF0, 0xE5, 0xE2, 0xEB, 0xEC, 0xC1, 0xC6, 0xCF, 0xC8, 0xDD, 0xDA, 0xD3, 0xD4,
+	0x69, 0x6E, 0x67, 0x60, 0x75, 0x72, 0x7B, 0x7C, 0x51, 0x56, 0x5F, 0x58, 0x4D, 0x4A, 0x43, 0x44,
+	0x19, 0x1E, 0x17, 0x10, 0x05, 0x02, 0x0B, 0x0C, 0x21, 0x26, 0x2F, 0x28, 0x3D, 0x3A, 0x33, 0x34,
+	0x4E, 0x49, 0x40, 0x47, 0x52, 0x55, 0x5C, 0x5B, 0x76, 0x71, 0x78, 0x7F, 0x6A, 0x6D, 0x64, 0x63,
+	0x3E, 0x39, 0x30, 0x37, 0x22, 0x25, 0x2C, 0x2B, 0x06, 0x01, 0x08, 0x0F, 0x1A, 0x1D, 0x14, 0x13,
+	0xAE, 0xA9, 0xA0, 0xA7, 0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83,
+	0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC, 0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3
+	};
+
+
+//---------------------------< E X P 2 _ T A B L E >----------------------------------------------------------
+//
+// 2^exponent for each 5-bit two's complement PMBus exponent, indexed by the raw 5 bits: 0-15 are 2^0 - 2^15,
+// 16-31 are 2^-16 - 2^-1.  Every entry is exact in a float so decoding with it gives the same result, bit for
+// bit, as powf(2.0, exponent) did.
+//
+
+static const float exp2_table[32] =
+	{
+	1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f,
+	256.0f, 512.0f, 1024.0f, 2048.0f, 4096.0f, 8192.0f, 16384.0f, 32768.0f,
+	1.0f/65536, 1.0f/32768, 1.0f/16384, 1.0f/8192, 1.0f/4096, 1.0f/2048, 1.0f/1024, 1.0f/512,
+	1.0f/256, 1.0f/128, 1.0f/64, 1.0f/32, 1.0f/16, 1.0f/8, 1.0f/4, 1.0f/2
+	};
+
+
 //---------------------------< S E T U P >--------------------------------------------------------------------
 /*!
 	@brief  Instantiates a new LCM300Q class to use the given base address
@@ -92,7 +209,7 @@ you can change their contents.
 			Add constructor(void) for default address of 0x5F
 */
 
-uint8_t Systronix_LCM300::setup (uint8_t base, i2c_t3 wire, char* name)
+uint8_t Systronix_LCM300::setup (uint8_t base, Systronix_LCM300_transport& transport, char* name)
 	{
 	if ((LCM300_BASE_MIN > base) || (LCM300_BASE_MAX < base))
 		{
@@ -101,12 +218,22 @@ uint8_t Systronix_LCM300::setup (uint8_t base, i2c_t3 wire, char* name)
 		}
 
 	_base = base;
-	_wire = wire;
+	_transport = &transport;			// shared, not copied: every supply on the net uses the same one
 	_wire_name = wire_name = name;		// protected and public
 	return SUCCESS;
 	}
 
 
+//
+// As above, with the shared i2c_t3 backend for wire
+//
+
+uint8_t Systronix_LCM300::setup (uint8_t base, i2c_t3& wire, char* name)
+	{
+	return setup (base, Systronix_LCM300_i2c_t3::shared (wire), name);
+	}
+
+
 //---------------------------< B E G I N >--------------------------------------------------------------------
 /*!
 	@brief  Join the I2C bus as a master at BaseAddr, 100 kHz clock
@@ -114,9 +241,8 @@ uint8_t Systronix_LCM300::setup (uint8_t base, i2c_t3 wire, char* name)
 
 void Systronix_LCM300::begin (i2c_pins pins)
 	{
-	_wire.begin(I2C_MASTER, 0x00, pins, I2C_PULLUP_EXT, I2C_RATE_100);	// join I2C as master
+	_transport->begin (pins);								// join I2C as master
 //	Serial.printf("LCM300 lib begin %s\r\n", _wire_name);
-	_wire.setDefaultTimeout(200000); // 200ms
 	}
 
 
@@ -136,25 +262,177 @@ uint8_t Systronix_LCM300::base_get(void)
 // Attempts to fetch the Vout Mode byte (voltage measurement exponent).  If successful, sets control.exists true, false else.
 //
 // Exponent is in the 5 lsbs; signed 2's complement; upper three bits may have value but for the exponent should
-// be set or cleared according to the state of bit 4 (sign bit); this is the sign extension.
+// be set or cleared according to the state of bit 4 (sign bit); this is the sign extension.  That is done by
+// identity_capture() whenever VOUT_MODE is read.
+//
+// When read_identity is true, also reads the rest of the static identity and limit commands (LCM300_IDENTITY_MASK)
+// into the identity cache so that they need never be read again.  A failure there doesn't make the device absent;
+// identity_valid() is false and identity_refresh() can try again later.
+//
+// An absent supply stays absent for command_read(); one driven by command_service() or Systronix_LCM300_bus is
+// re-probed in the background (see recovery_set()) and comes back by itself.
 //
 
-uint8_t Systronix_LCM300::init (void)
+uint8_t Systronix_LCM300::init (bool read_identity)
 	{
+	int	cmd_idx;
+
 	error.exists = true;								// here, assume that the device exists
 	if (SUCCESS != command_read (VOUT_MODE_CMD))		// did we get the raw exponent?
 		{
 		error.exists = false;							// unsuccessful i2c transaction
 		return ABSENT;
 		}
-														// sign extend the exponent to 8 bits
-	_linear_exponent = (cmd_response.as_byte & 0x10) ? (cmd_response.as_byte | 0xE0) : (cmd_response.as_byte & 0x1F);
-	_vout_mode = (cmd_response.as_byte & 0xE0) >> 5;	// shift mode bits into 3 lsbs
+
+	if (read_identity)
+		{
+		for (cmd_idx = 0; cmd_idx < CMD_ARRAY_SIZE; cmd_idx++)
+			{
+			if ((LCM300_IDENTITY_MASK & ~identity.valid) & CMD_MASK(cmd_idx))
+				command_read (cmd_idx);					// identity_capture() keeps the result
+			}
+		}
 
 	return SUCCESS;
 	}
 
 
+//---------------------------< P R O B E >--------------------------------------------------------------------
+//
+// Is anything at this address?  The address byte alone, with the transport's short probe timeout: no command,
+// so no 50ms wait for the communication interval first, and an empty slot costs about 100us instead of a
+// failed VOUT_MODE read.  The interval starts from the probe, as from any transaction.  Sets error.exists, but
+// reads nothing: a supply that answers needs init() or Systronix_LCM300_bus::discover() before it is useful.
+// An address that doesn't answer is absent with its re-probe backoff started, so once registered with a
+// Systronix_LCM300_bus it is re-probed in the background (recovery_set()) and found when a supply is plugged in.
+//
+// @return SUCCESS when the address was acknowledged, ABSENT otherwise, FAIL when a transaction is in progress
+//
+
+uint8_t Systronix_LCM300::probe (void)
+	{
+	uint8_t	ret_val;
+
+	if (XFER_IDLE != _xfer_state)							// an asynchronous read is using the supply
+		return FAIL;
+
+	stats_start ();
+	stats_bus ();
+	ret_val = _transport->probe (_base);
+	_last_xfer_us = micros();
+
+	error.exists = (SUCCESS == ret_val);
+	i2c_common.tally_transaction (ret_val, &error);
+	stats_write (0, error.exists ? SUCCESS : FAIL);
+	if (!error.exists)
+		{
+		_probe_ms = _probe_min_ms;							// first re-probe after the shortest backoff
+		recovery.offline_ms = millis();
+		recovery_hold (_probe_ms);
+		}
+	return error.exists ? SUCCESS : ABSENT;
+	}
+
+
+//---------------------------< I D E N T I T Y _ G E T >------------------------------------------------------
+
+const Systronix_LCM300::identity_t& Systronix_LCM300::identity_get (void)
+	{
+	return identity;
+	}
+
+
+//---------------------------< I D E N T I T Y _ V A L I D >--------------------------------------------------
+
+bool Systronix_LCM300::identity_valid (void)
+	{
+	return (LCM300_IDENTITY_MASK == (identity.valid & LCM300_IDENTITY_MASK));
+	}
+
+
+//---------------------------< I D E N T I T Y _ I N V A L I D A T E >----------------------------------------
+//
+// Forget everything in the identity cache.  Called by reset_bus(); call it too when the supply may have been
+// replaced.  The VOUT_MODE exponent in use by raw_voltage_to_float() is kept until VOUT_MODE is read again.
+// Learned block lengths go too: a replacement's strings may be longer, and a read of the old length would fail.
+//
+
+void Systronix_LCM300::identity_invalidate (void)
+	{
+	memset (&identity, 0, sizeof(identity));
+	output.valid = 0;										// limits and register values may have changed too
+	memset (_block_count, 0, sizeof(_block_count));			// next block reads are full length
+	}
+
+
+//---------------------------< I D E N T I T Y _ R E F R E S H >----------------------------------------------
+//
+// Queue reads of the identity fields that are not valid; read them with command_service() or Systronix_LCM300_bus.
+//
+
+void Systronix_LCM300::identity_refresh (void)
+	{
+	command_queue_mask (LCM300_IDENTITY_MASK & ~identity.valid);
+	}
+
+
+//---------------------------< I D E N T I T Y _ C A P T U R E >----------------------------------------------
+//
+// Called for every successful read.  When the command is one of the identity commands, copy the response into
+// the identity cache: ascii strings null-terminated, limits decoded to float.
+//
+
+void Systronix_LCM300::identity_capture (void)
+	{
+	char*	dest;
+	uint8_t	length;
+	uint8_t	raw = _xfer_data->as_byte;
+
+	if (!(LCM300_IDENTITY_MASK & CMD_MASK(_xfer_cmd_idx)))
+		return;
+
+	switch (_xfer_cmd_idx)
+		{
+		case VOUT_MODE_CMD:									// sign extend the exponent to 8 bits
+			_linear_exponent = (raw & 0x10) ? (raw | 0xE0) : (raw & 0x1F);
+			_vout_scale = exp2_table[raw & 0x1F];			// so raw_voltage_to_float() is one multiply
+			_vout_mode = (raw & 0xE0) >> 5;					// shift mode bits into 3 lsbs
+			identity.vout_mode = raw;
+			break;
+		case PMBUS_REVISION_CMD:	identity.pmbus_revision = raw;											break;
+		case MFR_VOUT_MIN_CMD:		identity.mfr_vout_min = raw_voltage_to_float (_xfer_data->as_word);	break;
+		case MFR_VOUT_MAX_CMD:		identity.mfr_vout_max = raw_voltage_to_float (_xfer_data->as_word);	break;
+		case MFR_IOUT_MAX_CMD:		identity.mfr_iout_max = pmbus_literal_to_float (_xfer_data->as_word);	break;
+		default:											// ascii
+			dest = identity_string (_xfer_cmd_idx);
+			length = (uint8_t)_xfer_data->as_array[0];		// as_array[0] holds length of the string
+			if (ASCII - 1 < length)
+				length = ASCII - 1;							// leave room for the null terminator
+			memcpy (dest, &_xfer_data->as_array[1], length);
+			dest[length] = '\0';
+			break;
+		}
+
+	identity.valid |= CMD_MASK(_xfer_cmd_idx);
+	}
+
+
+//---------------------------< I D E N T I T Y _ S T R I N G >------------------------------------------------
+
+char* Systronix_LCM300::identity_string (int cmd_idx)
+	{
+	switch (cmd_idx)
+		{
+		case MFR_ID_CMD:		return identity.mfr_id;
+		case MFR_MODEL_CMD:		return identity.mfr_model;
+		case MFR_REVISION_CMD:	return identity.mfr_revision;
+		case MFR_LOCATION_CMD:	return identity.mfr_location;
+		case MFR_DATE_CMD:		return identity.mfr_date;
+		default:				return identity.mfr_serial;
+		}
+	}
+
+
 //---------------------------< R E S E T _ B U S >------------------------------------------------------------
 /**
 	Invoke resetBus of whichever Wire net this class instance is using
@@ -162,7 +440,8 @@ uint8_t Systronix_LCM300::init (void)
 */
 void Systronix_LCM300::reset_bus (void)
 	{
-	_wire.resetBus();
+	_transport->reset_bus();
+	identity_invalidate();							// what's on the bus now may not be what was there before
 	}
 
 
@@ -173,7 +452,7 @@ void Systronix_LCM300::reset_bus (void)
 */
 uint32_t Systronix_LCM300::reset_bus_count_read(void)
 	{
-	return _wire.resetBusCountRead();
+	return _transport->reset_bus_count();
 	}
 
 
@@ -184,207 +463,2305 @@ uint32_t Systronix_LCM300::reset_bus_count_read(void)
 
 uint8_t Systronix_LCM300::clear_faults_cmd (void)
 	{
-	uint8_t ret_val;
+	return pmbus_write (LCM300_CLEAR_FAULTS_CMD, 0, 0);
+	}
+
+
+//---------------------------< P M B U S _ W R I T E >--------------------------------------------------------
+//
+// PMBus send byte (count 0), write byte (count 1), or write word (count 2, little endian) with PEC when it is
+// enabled.  Blocks only for whatever remains of the communication interval plus the transaction itself.
+//
+// @return SUCCESS, FAIL, or ABSENT
+//
+
+uint8_t Systronix_LCM300::pmbus_write (uint8_t cmd_byte, uint16_t value, uint8_t count)
+	{
+	uint8_t	ret_val;
+	uint8_t	packet[5] = {(uint8_t)(_base << 1), cmd_byte, (uint8_t)value, (uint8_t)(value >> 8)};
 
 	if (!error.exists)										// exit immediately if device does not exist
 		return ABSENT;
 
-	delay(50);												// exists; ensure that we meet datasheet communication interval spec
+	if (XFER_IDLE != _xfer_state)							// an asynchronous read is using the supply
+		return FAIL;
+
+	stats_start ();
+	interval_wait();										// exists; ensure that we meet datasheet communication interval spec
+	stats_bus ();
 
-	_wire.beginTransmission(_base);							// init tx buff for xmit to slave at _base address
-	ret_val = _wire.write (LCM300_CLEAR_FAULTS_CMD);		// add command byte to the tx buffer
-	if (1 != ret_val)
+	if (_pec)
+		packet[2 + count] = pec_crc8 (0, packet, 2 + count);	// the packet error check byte follows the data
+
+	ret_val = _transport->write (_base, &packet[1], (_pec ? 2 : 1) + count);	// command byte, data, PEC
+	if (1 == ret_val)										// didn't fit in the transmit buffer
 		{
-		i2c_common.tally_transaction (WR_INCOMPLETE, &error);					// only here 0 is error value since we expected to write more than 0 bytes
+		i2c_common.tally_transaction (WR_INCOMPLETE, &error);
+		stats_write (0, FAIL);
 		return FAIL;
 		}
 
-	ret_val = _wire.endTransmission();						// xmit command byte
+	_last_xfer_us = micros();								// start of the next communication interval
 	if (SUCCESS != ret_val)
 		{
 		i2c_common.tally_transaction (ret_val, &error);						// increment the appropriate counter
+		stats_write (0, FAIL);
 		return FAIL;										// calling function decides what to do with the error
 		}
 
 	i2c_common.tally_transaction (SUCCESS, &error);
+	stats_write ((_pec ? 2 : 1) + count, SUCCESS);
 	return SUCCESS;
 	}
 
 
-//---------------------------< C O M M A N D _ R E A D >------------------------------------------------------
-/**
-Read the RAW data received in response to cmd, store it in cmd_response.as_array[]
-Data could be any type, so an attempt to print as string may be unreadable.
-But it is useful for debug and exploration
-Note that PMBus reads are not memory locations, and whatever number you request seems to be "available"
-even if the data is really junk. For example you can "read" 'm' number of bytes from a command which only 
-returns 'n' actual data bytes. Usually n+1 is some consistent value <0xFF and n+[2,3,...] are 0xFF
-Note that byte 0 of LCM300 ascii commands is the length of the string, and string is not null terminated.
-@return SUCCESS, FAIL, or ABSENT
-*/
+//---------------------------< V O U T _ S E T >--------------------------------------------------------------
+//
+// Set the output voltage: volts encoded linear-16 with the VOUT_MODE exponent and written to VOUT_COMMAND.  volts
+// outside MFR_VOUT_MIN .. the lower of MFR_VOUT_MAX and VOUT_MAX is clamped to the nearer limit and counted in
+// output.clamp_count; output.vout_command is what the supply took.  VOUT_MODE, the limits, and VOUT_MAX are read
+// first if they haven't been; after that a trim is one write plus, with verify, one read back 50ms later.
+//
+// Without verify, call write_verify() before the next write; Systronix_LCM300_bus does that for a whole rack so
+// the read backs share one communication interval.
+//
+// @return SUCCESS, FAIL (bus error, write protected, or the read back doesn't match), or ABSENT
+//
 
-uint8_t Systronix_LCM300::command_read (int cmd_idx, bool debug)
+uint8_t Systronix_LCM300::vout_set (float volts, bool verify)
 	{
-	uint8_t ret_val;
-	size_t	count = cmd[cmd_idx].count;							// number of bytes to read
-	uint8_t index = 0;
+	uint32_t	limits = CMD_MASK(VOUT_MODE_CMD) | CMD_MASK(MFR_VOUT_MIN_CMD) | CMD_MASK(MFR_VOUT_MAX_CMD);
+	float		high;
+	int32_t		raw;
+	uint8_t		ret_val;
 
-	if (!error.exists)											// exit immediately if device does not exist
+	if (!error.exists)
 		return ABSENT;
 
-	delay(50);													// exists; ensure that we meet datasheet communication interval spec
-
-	_wire.beginTransmission (_base);							// base address
-	ret_val = _wire.write (cmd[cmd_idx].cmd_byte);				// PMBus command code
-
-	if (1 != ret_val)
+	for (int cmd_idx = 0; cmd_idx < CMD_ARRAY_SIZE; cmd_idx++)	// what we need to encode and clamp
 		{
-		i2c_common.tally_transaction (WR_INCOMPLETE, &error);						// increment the appropriate counter
-		return FAIL;
+		if ((limits & CMD_MASK(cmd_idx) & ~identity.valid) && (SUCCESS != command_read (cmd_idx)))
+			return FAIL;
 		}
-
-	_wire.endTransmission(I2C_NOSTOP); 							// don't send a stop condition, PMBus wants a repeated start
-
-	if (debug) Serial.printf("cmd 0x%X, ", cmd[cmd_idx].cmd_byte);
-
-	ret_val = _wire.requestFrom(_base, count, I2C_STOP);		// returns # of bytes received
-	if (0 == ret_val || ASCII < ret_val)						// 0 is error; so is more than 17
-		{
-		Serial.printf ("raw read: invalid response length: %d bytes\n", ret_val);
-		ret_val = _wire.status();								// to get error value
-		i2c_common.tally_transaction (ret_val, &error);							// increment the appropriate counter
+	if (!(output.valid & CMD_MASK(VOUT_MAX_CMD)) && (SUCCESS != command_read (VOUT_MAX_CMD)))
 		return FAIL;
-		}
-
-	if (debug) Serial.printf(" read %i bytes\r\n", ret_val);
 
-	while (_wire.available())
+	high = (output.vout_max < identity.mfr_vout_max) ? output.vout_max : identity.mfr_vout_max;
+	if ((volts < identity.mfr_vout_min) || (volts > high))
 		{
-		cmd_response.as_array[index] = _wire.readByte();
-		if (debug) Serial.printf("%u:0x%02X ", index, cmd_response.as_array[index]);
-		index++;
+		volts = (volts < identity.mfr_vout_min) ? identity.mfr_vout_min : high;
+		output.clamp_count++;
 		}
 
-	if (ASCII == count)											// an ascii response so null terminate it
-		{														// as_array[0] holds length of remaining response in bytes
-		index = cmd_response.as_array[0] + 1;					// <length>+1 is index of null terminator
-		cmd_response.as_array[index] = '\0';					// null terminate
-		}
+	raw = lroundf (volts / _vout_scale);
+	if (0xFFFF < raw)
+		raw = 0xFFFF;
 
-	if (debug) Serial.printf ("\n");
+	if (SUCCESS != (ret_val = write_check (VOUT_COMMAND_CMD)))
+		return ret_val;
 
-	i2c_common.tally_transaction (SUCCESS, &error);
-	return SUCCESS;
+	ret_val = pmbus_write (VOUT_COMMAND_CMD_VAL, (uint16_t)raw, 2);
+	if (SUCCESS != ret_val)
+		return ret_val;
+
+	output.write_count++;
+	_verify_cmd_idx = VOUT_COMMAND_CMD;
+	_verify_raw = (uint16_t)raw;
+	return verify ? write_verify() : SUCCESS;
 	}
 
 
-//---------------------------< R A W _ V O L T A G E _ T O _ F L O A T >--------------------------------------
-//
-// Voltage measurements appear to be rendered in a different form from all other linear measurements reported
-// by the LCM300.  These measurements use a separate exponent read from the LCM300 with the VOUT_MODE_CMD (0x20).
-//
-// _linear_exponent is set by init() and is simply a sign-extended version of the raw value returned by the
-// VOUT_MODE_CMD (0x20)
+//---------------------------< O P E R A T I O N _ S E T >----------------------------------------------------
 //
-// result = mantissa * 2.0^exponent
+// Write OPERATION: LCM300_OPERATION_OFF, _ON, _MARGIN_LOW, or _MARGIN_HIGH.  output_set() and margin_set() are
+// the same with friendlier arguments.
 //
-// This function assumes that _linear_exponent has been set to a valid value before this function is called.
-// should not normally be an issue because _linear_exponent is set by init().
+// @return SUCCESS, FAIL (bus error, write protected, or the read back doesn't match), or ABSENT
 //
 
-float Systronix_LCM300::raw_voltage_to_float (uint16_t volt_raw)
+uint8_t Systronix_LCM300::operation_set (uint8_t operation, bool verify)
 	{
-	return (float)volt_raw * powf (2.0, (float)_linear_exponent);
+	uint8_t	ret_val;
+
+	if (SUCCESS != (ret_val = write_check (OPERATION_CMD)))
+		return ret_val;
+
+	ret_val = pmbus_write (LCM300_OPERATION_CMD, operation, 1);
+	if (SUCCESS != ret_val)
+		return ret_val;
+
+	output.write_count++;
+	_verify_cmd_idx = OPERATION_CMD;
+	_verify_raw = operation;
+	return verify ? write_verify() : SUCCESS;
 	}
 
 
-//---------------------------< P M B U S _ L I T E R A L _ T O _ F L O A T >----------------------------------
+uint8_t Systronix_LCM300::output_set (bool on, bool verify)
+	{
+	return operation_set (on ? LCM300_OPERATION_ON : LCM300_OPERATION_OFF, verify);
+	}
+
+
+uint8_t Systronix_LCM300::margin_set (int8_t direction, bool verify)
+	{
+	if (0 > direction)
+		return operation_set (LCM300_OPERATION_MARGIN_LOW, verify);
+	if (0 < direction)
+		return operation_set (LCM300_OPERATION_MARGIN_HIGH, verify);
+	return operation_set (LCM300_OPERATION_ON, verify);
+	}
+
+
+//---------------------------< W R I T E _ P R O T E C T _ S E T >--------------------------------------------
 //
-// PMbus literal values are 16-bit values where:
-//		[15..11]	signed 2's complement exponent
-//		[10..0]		signed 2's complement mantissa
-// to calculate float value, extract exponent, sign extend so that exponent lsb from literal is now in bit 0.
-// sign extend the mantissa
-// result = mantissa * 2.0^exponent
+// Write WRITE_PROTECT: LCM300_WP_ENABLE_ALL, _ENABLE_OPER_PAGE_ONOFF_VOUT (what vout_set() and margin_set()
+// need), _ENABLE_OPER_PAGE, or _DISABLE_ALL.  WRITE_PROTECT itself is always writable.
+//
+// @return SUCCESS, FAIL (bus error or the read back doesn't match), or ABSENT
 //
 
-float Systronix_LCM300::pmbus_literal_to_float (uint16_t literal_raw)
+uint8_t Systronix_LCM300::write_protect_set (uint8_t write_protect, bool verify)
 	{
-	int16_t		exponent = (int16_t)(literal_raw & 0xF800) >> 11;							// get the exponent; int16_t cast required because 0xF800 is uint16_t
-	int16_t		mantissa = literal_raw;														// get the mantissa
-				mantissa = (mantissa & 0x0400) ? mantissa | 0xF800 : mantissa & 0x07FF;		// sign extend the mantissa
+	uint8_t	ret_val;
+
+	ret_val = pmbus_write (LCM300_WRITE_PROTECT_CMD, write_protect, 1);
+	if (SUCCESS != ret_val)
+		return ret_val;
 
-	return (float)mantissa * powf (2.0, (float)exponent);
+	output.write_count++;
+	_verify_cmd_idx = WRITE_PROTECT_CMD;
+	_verify_raw = write_protect;
+	return verify ? write_verify() : SUCCESS;
 	}
 
 
-//---------------------------< P M B U S _ A V E R A G E _ P O W E R >----------------------------------------
+//---------------------------< W R I T E _ V E R I F Y >------------------------------------------------------
 //
-// Calculate average power.  From PMBus Power System Mgt Protocol Specification 1.2 part II section 10.13 page 87,
-// this calculation:
-//		average_power = (energy_count - last_energy _count) / (sample_count - last_sample_count)
+// Read back the register of the last write made without verify and compare.  A supply that refuses a write
+// (write protected, value out of its range) still ACKs it, so this is the only way to know the write took.
 //
-// where energy_count is the result from this equation:
+// @return SUCCESS (also when there is nothing to verify), FAIL, or ABSENT
 //
-//	energy_count = rollover_count * maximum_direct_format_value + accumulator_value
-//		where:
-//			coefficients: m=1, b=0, R=0
-//			Ymax = 2^15-1 = 32767
-//			maximum_direct_format_value = (mYmax + b) * 10^R = (1Ymax + 0) * 10^R = (1 * 32767 + 0) * 10^0 = 32767
+
+uint8_t Systronix_LCM300::write_verify (void)
+	{
+	uint8_t		ret_val;
+	uint16_t	raw;
+
+	if (0 > _verify_cmd_idx)
+		return SUCCESS;
+
+	ret_val = command_read (_verify_cmd_idx);
+	if (SUCCESS != ret_val)
+		return ret_val;										// keep _verify_cmd_idx; try again later
+
+	raw = (A_BYTE == cmd[_verify_cmd_idx].count) ? cmd_response.as_byte : cmd_response.as_word;
+	_verify_cmd_idx = -1;
+	if (raw != _verify_raw)
+		{
+		output.verify_fail_count++;
+		return FAIL;
+		}
+	return SUCCESS;
+	}
+
+
+//---------------------------< W R I T E _ C H E C K >--------------------------------------------------------
 //
-// this function does all maintenance of the eout_data struct.
+// Whether the WRITE_PROTECT value last read back allows a write to cmd_idx; anything goes while it is unknown.
+// Saves a write and a read back that can only fail.
 //
-// this function must be called directly after a call to command_read (READ_EOUT_CMD)
+
+uint8_t Systronix_LCM300::write_check (int cmd_idx)
+	{
+	bool	allowed = true;
+
+	if (!(output.valid & CMD_MASK(WRITE_PROTECT_CMD)))
+		return SUCCESS;
+
+	switch (output.write_protect)
+		{
+		case LCM300_WP_ENABLE_ALL:
+			break;
+		case LCM300_WP_ENABLE_OPER_PAGE_ONOFF_VOUT:
+			allowed = (OPERATION_CMD == cmd_idx) || (VOUT_COMMAND_CMD == cmd_idx);
+			break;
+		case LCM300_WP_ENABLE_OPER_PAGE:
+			allowed = (OPERATION_CMD == cmd_idx);
+			break;
+		default:
+			allowed = false;
+			break;
+		}
+
+	if (allowed)
+		return SUCCESS;
+	output.protect_count++;
+	return FAIL;
+	}
+
+
+//---------------------------< O U T P U T _ C A P T U R E >--------------------------------------------------
 //
-// Accumulator:  the accumulator value is believed to be in PMBus direct format event though the 1v5 data sheet
-// indicates that the READ_EOUT command returns 2 bytes in linear format.  Treating accumulator as if it is a
-// PMBus linear value produces irrational results (often negative power) which indicates that accumulator cannot
-// be PMBus linear.  The max value for accumulator in PMBus direct format is 32767 given the coefficients stated
-// in the data sheet m=1, b=0, R=0.
+// Called for every successful read.  Keep the write path's copies of the registers it writes, and VOUT_MAX.
+//
+
+void Systronix_LCM300::output_capture (void)
+	{
+	switch (_xfer_cmd_idx)
+		{
+		case VOUT_COMMAND_CMD:	output.vout_command = raw_voltage_to_float (_xfer_data->as_word);	break;
+		case VOUT_MAX_CMD:		output.vout_max = raw_voltage_to_float (_xfer_data->as_word);		break;
+		case OPERATION_CMD:		output.operation = _xfer_data->as_byte;								break;
+		case WRITE_PROTECT_CMD:	output.write_protect = _xfer_data->as_byte;							break;
+		default:				return;
+		}
+	output.valid |= CMD_MASK(_xfer_cmd_idx);
+	}
+
+
+//---------------------------< C O M M A N D _ R E A D >------------------------------------------------------
+/**
+Read the RAW data received in response to cmd, store it in cmd_response.as_array[]
+Data could be any type, so an attempt to print as string may be unreadable.
+But it is useful for debug and exploration
+Note that PMBus reads are not memory locations, and whatever number you request seems to be "available"
+even if the data is really junk. For example you can "read" 'm' number of bytes from a command which only 
+returns 'n' actual data bytes. Usually n+1 is some consistent value <0xFF and n+[2,3,...] are 0xFF
+Note that byte 0 of LCM300 ascii commands is the length of the string, and string is not null terminated.
+
+Blocks only for whatever remains of the communication interval plus the transaction itself.
+@return SUCCESS, FAIL, or ABSENT
+*/
+
+uint8_t Systronix_LCM300::command_read (int cmd_idx, bool debug)
+	{
+	uint8_t ret_val;
+
+	ret_val = xfer_start (cmd_idx, NULL, debug);			// response into cmd_response
+	if (SUCCESS != ret_val)
+		return ret_val;
+
+	do
+		ret_val = command_poll ();
+	while (LCM300_PENDING == ret_val);
+
+	return ret_val;
+	}
+
+
+//---------------------------< D E C O D E _ R E S P O N S E >------------------------------------------------
 //
-// When accumulator overflows, rollover_counter is incremented (this too may rollover at rc = 255).  Because
-// rollover_counter multiplies maximum_direct_format_value when calculating energy_count, when rollover_count
-// rolls over to zero it is different from the rollover_count used to make last_energy_count, so average_power
-// will be obviously wrong.  To get round that, when rollover_count is less than last_rollover_count, we modify
-// accumulator by adding 32768 and use last_rollover_count to calculate the current energy_count.  These 'spoofing'
-// values are not retained beyond the current energy_count calculation.
+// cmd_response, as read for cmd_idx, in the type read<>() gives for that command's cmd[].format.  Pointers are
+// into the identity cache (ascii) or cmd_response (READ_EOUT frame) and good until the next read.
 //
 
-void Systronix_LCM300::pmbus_average_power (void)
+void Systronix_LCM300::decode_response (int cmd_idx, float& value)
+	{
+	value = decode (cmd_idx, (LCM300_FMT_BYTE == cmd[cmd_idx].format) ? cmd_response.as_byte : cmd_response.as_word);
+	}
+
+
+void Systronix_LCM300::decode_response (int cmd_idx, uint8_t& value)
 	{
-	uint32_t	iaccumulator;											// intermediate values that will be used in the calculations
-	uint32_t	irollover_count;										// uint32 because intermediate results can be 25 bits
-	uint32_t	isample_count;
-	uint32_t	correction;												// used when rollover counter rolls over to 0
+	(void)cmd_idx;
+	value = cmd_response.as_byte;
+	}
 
-	eout_data.accumulator = *(uint16_t*)&cmd_response.as_array[1];		// get newly read raw data from command response union
-	eout_data.rollover_count = cmd_response.as_array[3];
-	eout_data.sample_count = *(uint32_t*)&cmd_response.as_array[4] & 0x00FFFFFF;	// 24 bits of sample count may have PEC so mask that off
 
-	if (eout_data.rollover_count < eout_data.last_rollover_count)		// accumulator overflow occurs at 32767; handle the case when accumulator overflow
-		{																// causes rollover_counter to rollover to 0.  When this happens we create spoof
-		irollover_count = (uint32_t)eout_data.last_rollover_count;		// values for energy_count calculation by using last time's rollover_count.
-																		// Because accumulator may have rolled over multiple times since last reading
-																		// which may have caused rollover counter to rollover, calculate an accumulator
-		correction = ((eout_data.rollover_count + 256) - eout_data.last_rollover_count) * 32768;	// correction to be added to accumulator.  Only valid
-		iaccumulator = (uint32_t)eout_data.accumulator + correction;	// a single rollover counter rollover
-		}
-	else
-		{																// no accumulator overflow
-		irollover_count = (uint32_t)eout_data.rollover_count;			// so no spoofing required
-		iaccumulator = (uint32_t)eout_data.accumulator;
-		}
-																		// when sample_count rolls over spoof the calculation by showing the rollover in isample_count
-																		// rollover occurs at 16777215 (0x00FFFFFF)
-	isample_count = (eout_data.sample_count < eout_data.last_sample_count) ? eout_data.last_sample_count + 16777216 : eout_data.sample_count;	// 0x01000000 = 2^24
+void Systronix_LCM300::decode_response (int cmd_idx, uint16_t& value)
+	{
+	(void)cmd_idx;
+	value = cmd_response.as_word;
+	}
 
-	eout_data.energy_count = irollover_count * 32767 + iaccumulator;	// calculate new energy count
-	eout_data.average_power = (eout_data.energy_count - eout_data.last_energy_count) / (isample_count - eout_data.last_sample_count);	// calculate average power
 
-	if (eout_data.rollover_count < eout_data.last_rollover_count)		// when rollover_counter rolls over, calculate new last energy count using rolled over values
-		eout_data.energy_count = eout_data.rollover_count * 32767 + eout_data.accumulator;	// from the most recent READ_EOUT command
+void Systronix_LCM300::decode_response (int cmd_idx, const char*& value)
+	{
+	value = identity_string (cmd_idx);						// identity_capture() has copied and terminated it
+	}
 
-	eout_data.last_energy_count = eout_data.energy_count;				// and save new 'lasts'
-	eout_data.last_sample_count = eout_data.sample_count;				// always this even when it has rolled over
-	eout_data.last_rollover_count = eout_data.rollover_count;
+
+void Systronix_LCM300::decode_response (int cmd_idx, const uint8_t*& value)
+	{
+	(void)cmd_idx;
+	value = (const uint8_t*)cmd_response.as_array;
+	}
+
+
+//---------------------------< D E C O D E >------------------------------------------------------------------
+//
+// A raw byte or word response to cmd_idx in engineering units per cmd[].format: linear-16 with this supply's
+// VOUT_MODE exponent, linear-11, fan speed direct; status and other byte / word commands as is.
+//
+
+float Systronix_LCM300::decode (int cmd_idx, uint16_t raw)
+	{
+	switch (cmd[cmd_idx].format)
+		{
+		case LCM300_FMT_LINEAR16:	return raw_voltage_to_float (raw);
+		case LCM300_FMT_LINEAR11:	return pmbus_literal_to_float (raw);
+		default:					return raw;
+		}
+	}
+
+
+//---------------------------< C O M M A N D _ S T A R T >----------------------------------------------------
+/**
+Begin a non-blocking read of the command indexed by cmd_idx. Nothing is put on the bus here; call
+command_poll() until it returns something other than LCM300_PENDING.
+
+command_start() puts the response into the next response_t of the response_ring_set() ring (the built-in
+slot when there is none) and command_start_into() into dest, never into cmd_response: a read started here doesn't disturb a response
+someone else is still decoding.  dest->result is LCM300_PENDING until the read completes.  dest must stay
+put until then and must not be NULL.
+@return SUCCESS when the command is accepted, FAIL when a transaction is already in progress or cmd_idx
+is out of range or dest is NULL, ABSENT when the device does not exist
+*/
+
+uint8_t Systronix_LCM300::command_start (int cmd_idx, bool debug)
+	{
+	response_t*	slot = response_slot (_ring_seq + 1);
+	uint8_t		ret_val;
+
+	ret_val = xfer_start (cmd_idx, slot, debug);
+	if (SUCCESS == ret_val)
+		slot->seq = ++_ring_seq;
+	return ret_val;
+	}
+
+uint8_t Systronix_LCM300::command_start_into (int cmd_idx, response_t* dest, bool debug)
+	{
+	if (!error.exists)											// exit immediately if device does not exist
+		return ABSENT;
+
+	if (!dest)
+		{
+		i2c_common.tally_transaction (SILLY_PROGRAMMER, &error);
+		return FAIL;
+		}
+
+	return xfer_start (cmd_idx, dest, debug);
+	}
+
+
+//---------------------------< X F E R _ S T A R T >----------------------------------------------------------
+//
+// Set up the transaction for command_poll(): the response into dest, or into cmd_response when dest is NULL
+// (command_read()).  Returns as command_start().
+//
+
+uint8_t Systronix_LCM300::xfer_start (int cmd_idx, response_t* dest, bool debug)
+	{
+	if (!error.exists)											// exit immediately if device does not exist
+		return ABSENT;
+
+	if ((0 > cmd_idx) || (CMD_ARRAY_SIZE <= cmd_idx))
+		{
+		i2c_common.tally_transaction (SILLY_PROGRAMMER, &error);
+		return FAIL;
+		}
+
+	if (XFER_IDLE != _xfer_state)								// one transaction at a time
+		return FAIL;
+
+	_xfer_cmd_idx = cmd_idx;
+	_xfer_debug = debug;
+	_xfer_response = dest;
+	_xfer_data = dest ? &dest->data : &cmd_response;
+	if (dest)
+		{
+		dest->cmd_idx = cmd_idx;
+		dest->result = LCM300_PENDING;
+		dest->seq = 0;
+		}
+	_xfer_state = XFER_INTERVAL;
+	stats_start ();
+	return SUCCESS;
+	}
+
+
+//---------------------------< C O M M A N D _ P O L L >------------------------------------------------------
+/**
+Advance the transaction begun by command_start(). Each call does at most one step and never waits:
+	XFER_INTERVAL	communication interval not yet elapsed; when it has, send the command byte without a stop
+	XFER_WRITE		command byte in flight; when done, request the response with a repeated start
+	XFER_READ		response in flight; when done, copy it into the response buffer
+When no transaction is in progress, returns the result of the last one.
+@return LCM300_PENDING while the transaction is in progress, else SUCCESS or FAIL
+*/
+
+uint8_t Systronix_LCM300::command_poll (void)
+	{
+	uint8_t ret_val;
+
+	switch (_xfer_state)
+		{
+		case XFER_INTERVAL:
+			if (interval_remaining())								// too soon to talk to this supply
+				return LCM300_PENDING;
+
+			stats_bus ();
+			if (_xfer_debug) Serial.printf("cmd 0x%X, ", cmd[_xfer_cmd_idx].cmd_byte);
+
+			if (!_transport->write_start (_base, &cmd[_xfer_cmd_idx].cmd_byte, 1, false))	// PMBus command code; no stop,
+				{																			// PMBus wants a repeated start
+				i2c_common.tally_transaction (WR_INCOMPLETE, &error);	// increment the appropriate counter
+				return xfer_end (FAIL);
+				}
+			_xfer_state = XFER_WRITE;
+			return LCM300_PENDING;
+
+		case XFER_WRITE:
+			if (!_transport->done())
+				return LCM300_PENDING;
+
+			ret_val = _transport->status();
+			if (I2C_WAITING != ret_val)								// command byte not acknowledged, timeout, etc
+				{
+				i2c_common.tally_transaction (ret_val, &error);
+				return xfer_end (FAIL);
+				}
+
+			_transport->read_start (_base, read_count (_xfer_cmd_idx), true);
+			_xfer_state = XFER_READ;
+			return LCM300_PENDING;
+
+		case XFER_READ:
+			if (!_transport->done())
+				return LCM300_PENDING;
+
+			return xfer_end (response_get ());
+
+		default:													// XFER_IDLE
+			return _xfer_result;
+		}
+	}
+
+
+//---------------------------< R E S P O N S E _ L A S T >----------------------------------------------------
+//
+// Responses to command_start() reads.  response_last() is the most recently completed one, in the ring or a
+// caller-supplied buffer.  Each ring response has a sequence number, response_seq() is the most recent; a
+// consumer that remembers one can check with response_find() that the ring has not reused its slot since.
+//
+// response_ring_set() gives the instance a ring of count response_t of the sketch's own; LCM300_RESPONSE_RING
+// is a good size.  Without one, or with NULL, every command_start() response goes in the one built-in slot.
+// Not while a command_start() read is in flight.
+// @return SUCCESS, or FAIL when a read is in flight or ring is not NULL and count is 0
+//
+
+uint8_t Systronix_LCM300::response_ring_set (response_t* ring, uint8_t count)
+	{
+	if (command_busy() || (ring && (0 == count)))
+		return FAIL;
+
+	_ring = ring;
+	_ring_size = ring ? count : 0;
+	if (ring)
+		memset (ring, 0, count * sizeof(response_t));
+	memset (&_response, 0, sizeof(_response));
+	_last_response = NULL;
+	_ring_seq = 0;
+	return SUCCESS;
+	}
+
+
+Systronix_LCM300::response_t* Systronix_LCM300::response_slot (uint32_t seq)
+	{
+	return _ring ? &_ring[seq % _ring_size] : &_response;
+	}
+
+
+
+const Systronix_LCM300::response_t* Systronix_LCM300::response_last (void)
+	{
+	return _last_response;
+	}
+
+
+const Systronix_LCM300::response_t* Systronix_LCM300::response_find (uint32_t seq)
+	{
+	response_t*	slot = response_slot (seq);
+
+	if (seq && (seq == slot->seq) && (LCM300_PENDING != slot->result))
+		return slot;
+	return NULL;
+	}
+
+
+uint32_t Systronix_LCM300::response_seq (void)
+	{
+	return _ring_seq;
+	}
+
+
+//---------------------------< C O M M A N D _ B U S Y >------------------------------------------------------
+//
+// true from command_start() until command_poll() returns the result
+//
+
+bool Systronix_LCM300::command_busy (void)
+	{
+	return (XFER_IDLE != _xfer_state);
+	}
+
+
+//---------------------------< C O M M A N D _ I D X _ G E T >------------------------------------------------
+//
+// cmd[] index of the transaction in progress or, when idle, of the most recent transaction
+//
+
+int Systronix_LCM300::command_idx_get (void)
+	{
+	return _xfer_cmd_idx;
+	}
+
+
+//---------------------------< C O M M A N D _ Q U E U E >----------------------------------------------------
+//
+// The command queue is a bit mask of cmd[] indexes waiting to be read.  Queuing a command that is already
+// queued does nothing so a queue can never overflow.  Nothing here touches the bus; whoever drives this
+// instance (Systronix_LCM300_bus::tick() for example) uses command_dequeue() to decide what to read next.
+//
+
+void Systronix_LCM300::command_queue (int cmd_idx)
+	{
+	if ((0 > cmd_idx) || (CMD_ARRAY_SIZE <= cmd_idx))
+		{
+		i2c_common.tally_transaction (SILLY_PROGRAMMER, &error);
+		return;
+		}
+	_queue_mask |= CMD_MASK(cmd_idx);
+	}
+
+
+void Systronix_LCM300::command_queue_mask (uint32_t mask)
+	{
+	_queue_mask |= mask & (CMD_MASK(CMD_ARRAY_SIZE) - 1);		// ignore bits that aren't cmd[] indexes
+	}
+
+
+uint32_t Systronix_LCM300::command_queued (void)
+	{
+	return _queue_mask;
+	}
+
+
+void Systronix_LCM300::command_queue_clear (void)
+	{
+	_queue_mask = 0;
+	_telemetry_sweep_mask = 0;								// abandon a sweep in progress
+	}
+
+
+//---------------------------< C O M M A N D _ D E Q U E U E >------------------------------------------------
+//
+// Remove the highest priority queued cmd[] index from the queue and return it; -1 when the queue is empty.
+// Commands without a schedule_set() priority are priority 0; among equals the lowest-numbered goes first.
+//
+
+int Systronix_LCM300::command_dequeue (void)
+	{
+	schedule_t*	slot;
+	int			best = -1;
+	uint8_t		best_priority = 0;
+
+	if (0 == _queue_mask)
+		return -1;
+
+	for (uint8_t i=0; i<_schedule_count; i++)				// queued commands with a priority of their own
+		{
+		slot = &_schedule[i];
+		if (!slot->period_max_ms || !slot->priority || !(_queue_mask & CMD_MASK(slot->cmd_idx)))
+			continue;
+		if ((slot->priority > best_priority) || ((slot->priority == best_priority) && (slot->cmd_idx < best)))
+			{
+			best = slot->cmd_idx;
+			best_priority = slot->priority;
+			}
+		}
+	if (0 > best)
+		best = __builtin_ctz (_queue_mask);					// all priority 0: the lowest-numbered
+
+	_queue_mask &= ~CMD_MASK(best);
+	return best;
+	}
+
+
+//---------------------------< C O M M A N D _ S E R V I C E >------------------------------------------------
+//
+// For an instance that is not registered with a Systronix_LCM300_bus: call from loop() to read queued commands.
+// Each call advances the transaction in progress or, when the communication interval has elapsed, starts the
+// next queued command.  Failed commands are retried and an absent supply re-probed per recovery_set().  Never
+// blocks.
+//
+// @return LCM300_PENDING while a transaction is in progress or commands remain queued, SUCCESS when the queue
+// is empty, ABSENT when the device does not exist (the queue is discarded)
+//
+
+uint8_t Systronix_LCM300::command_service (void)
+	{
+	uint8_t	ret_val;
+
+	if (command_busy())
+		{
+		ret_val = command_poll();
+		if (LCM300_PENDING == ret_val)
+			return LCM300_PENDING;
+		recovery_result (ret_val);							// retries are queued again
+		}
+
+	if (_fault_clear_pending)
+		fault_clear_service ();								// does nothing until the supply is free
+
+	if (!error.exists)
+		{
+		command_queue_clear();
+		if (recovery_probe_due() && !interval_remaining())
+			recovery_probe_start ();
+		return ABSENT;
+		}
+
+	if (!_queue_mask)
+		return _fault_clear_pending ? LCM300_PENDING : SUCCESS;
+
+	if (interval_remaining() || recovery_holding())
+		return LCM300_PENDING;
+
+	if (SUCCESS == command_start (command_dequeue()))
+		command_poll();										// interval has elapsed so this puts the command byte on the bus
+
+	return LCM300_PENDING;
+	}
+
+
+//---------------------------< R E S P O N S E _ G E T >------------------------------------------------------
+//
+// Copy the bytes received by the XFER_READ step into cmd_response or the command_start() response buffer.  For
+// block reads, check the length byte against what the command allows and what was received, remember it for
+// the next read of this command, and null terminate the response.
+//
+
+uint8_t Systronix_LCM300::response_get (void)
+	{
+	uint8_t ret_val;
+	uint8_t index = 0;
+	uint8_t	length;
+
+	ret_val = _transport->available();						// # of bytes received
+	if (0 == ret_val || sizeof(_xfer_data->as_array) < ret_val)	// 0 is error; so is more than 17 (18 with PEC)
+		{
+		if (_xfer_debug) Serial.printf ("raw read: invalid response length: %d bytes\n", ret_val);
+		ret_val = _transport->status();							// to get error value
+		i2c_common.tally_transaction (ret_val, &error);							// increment the appropriate counter
+		return FAIL;
+		}
+
+	if (_xfer_debug) Serial.printf(" read %i bytes\r\n", ret_val);
+
+	if (ret_val < read_count (_xfer_cmd_idx))					// not as many as requested
+		{
+		pmbus_error.short_read_count++;
+#if LCM300_INSTRUMENTATION
+		if (_stats)
+			_stats->short_read_count++;
+#endif
+		_transport->read (NULL, ret_val);						// discard
+		i2c_common.tally_transaction (LCM300_RD_INVALID, &error);
+		return FAIL;
+		}
+
+	index = _transport->read ((uint8_t*)_xfer_data->as_array, ret_val);
+	if (_xfer_debug)
+		{
+		for (uint8_t i=0; i<index; i++)
+			Serial.printf("%u:0x%02X ", i, _xfer_data->as_array[i]);
+		}
+
+	if (is_block (_xfer_cmd_idx))
+		{
+		length = (uint8_t)_xfer_data->as_array[0];				// as_array[0] holds length of remaining response in bytes
+		if ((length >= cmd[_xfer_cmd_idx].count) ||				// more than this command can return
+			((length + (_pec ? 1 : 0)) >= index) ||				// more than we received (+ PEC); string changed length?
+			((READ_EOUT_CMD == _xfer_cmd_idx) && ((EOUT - 1) != length)))	// eout payload is always 6 bytes
+			{
+			if (_xfer_debug) Serial.printf ("\nblock length error: %u\n", length);
+			pmbus_error.block_length_count++;
+			_block_count[_xfer_cmd_idx] = 0;					// next time, read full length
+			_xfer_data->as_array[0] = 0;						// don't leave an unterminated string behind
+			_xfer_data->as_array[1] = '\0';
+			i2c_common.tally_transaction (LCM300_RD_INVALID, &error);
+			return FAIL;
+			}
+
+		if (_pec && !pec_check (length + 1))					// PEC follows the last byte of the block
+			return FAIL;
+
+		_block_count[_xfer_cmd_idx] = length + 1;				// read exactly this much next time
+		_xfer_data->as_array[length + 1] = '\0';				// null terminate; length + 1 <= ASCII so always in as_array[]
+		}
+	else if (_pec && !pec_check (cmd[_xfer_cmd_idx].count))	// PEC follows the fixed-length response
+		return FAIL;
+
+	if (_xfer_debug) Serial.printf ("\n");
+
+	i2c_common.tally_transaction (SUCCESS, &error);
+	return SUCCESS;
+	}
+
+
+//---------------------------< R E A D _ C O U N T >----------------------------------------------------------
+//
+// Number of bytes to request for cmd_idx: the length learned from the last good block read, else the length in
+// the cmd[] table.
+//
+
+uint8_t Systronix_LCM300::read_count (int cmd_idx)
+	{
+	return (_block_count[cmd_idx] ? _block_count[cmd_idx] : cmd[cmd_idx].count) + (_pec ? 1 : 0);
+	}
+
+
+//---------------------------< P E C _ C H E C K >------------------------------------------------------------
+//
+// The PEC of a read covers the write address, command code, read address and count response bytes; the PEC byte
+// itself is as_array[count] of the response.  On mismatch count the error in pmbus_error and error_t.
+//
+
+bool Systronix_LCM300::pec_check (uint8_t count)
+	{
+	uint8_t	header[3] = {(uint8_t)(_base << 1), cmd[_xfer_cmd_idx].cmd_byte, (uint8_t)((_base << 1) | 1)};
+	uint8_t	crc;
+
+	crc = pec_crc8 (0, header, 3);
+	crc = pec_crc8 (crc, (uint8_t*)_xfer_data->as_array, count);
+
+	if (crc == (uint8_t)_xfer_data->as_array[count])
+		return true;
+
+	if (_xfer_debug) Serial.printf ("\nPEC error: 0x%02X expected 0x%02X\n", (uint8_t)_xfer_data->as_array[count], crc);
+	pmbus_error.pec_count++;
+	i2c_common.tally_transaction (LCM300_RD_INVALID, &error);	// a corrupt reading is a failed transaction
+	return false;
+	}
+
+
+//---------------------------< P E C _ C R C 8 >--------------------------------------------------------------
+//
+// Continue the CRC-8 crc over count bytes of data; start with crc = 0.  One table lookup per byte.
+//
+
+uint8_t Systronix_LCM300::pec_crc8 (uint8_t crc, const uint8_t* data, size_t count)
+	{
+	while (count--)
+		crc = pec_table[crc ^ *data++];
+	return crc;
+	}
+
+
+//---------------------------< P E C _ S E T >----------------------------------------------------------------
+//
+// Turn PMBus packet error checking on or off.  Takes effect with the next transaction.
+//
+
+void Systronix_LCM300::pec_set (bool enable)
+	{
+	_pec = enable;
+	}
+
+
+bool Systronix_LCM300::pec_get (void)
+	{
+	return _pec;
+	}
+
+
+//---------------------------< I S _ B L O C K >--------------------------------------------------------------
+//
+// PMBus block read commands return a length byte followed by that many bytes
+//
+
+bool Systronix_LCM300::is_block (int cmd_idx)
+	{
+	return (ASCII == cmd[cmd_idx].count) || (READ_EOUT_CMD == cmd_idx);
+	}
+
+
+//---------------------------< X F E R _ E N D >--------------------------------------------------------------
+//
+// Transaction complete, successful or not; the communication interval starts now.
+//
+
+uint8_t Systronix_LCM300::xfer_end (uint8_t result)
+	{
+	uint32_t	ms = millis();							// one time for the energy meter and the response
+
+	_last_xfer_us = micros();
+	_xfer_state = XFER_IDLE;
+	_xfer_result = result;
+	_xfer_status = (SUCCESS == result) ? (uint8_t)I2C_WAITING : (uint8_t)_transport->status();
+	stats_end (result);
+
+	if (SUCCESS == result)
+		{
+		telemetry_capture ();								// keep the snapshot, identity cache, and energy meter current
+		identity_capture ();								// no matter who asked for the read
+		fault_capture ();
+		output_capture ();
+		if (READ_EOUT_CMD == _xfer_cmd_idx)
+			energy_update (energy, (const uint8_t*)_xfer_data->as_array, ms,
+				(telemetry.valid & CMD_MASK(READ_POUT_CMD)) ? telemetry.pout : -1);
+		}
+
+	schedule_capture (SUCCESS == result);
+
+	if (_xfer_response)
+		{
+		_xfer_response->ms = ms;
+		_xfer_response->us = _last_xfer_us;
+		_xfer_response->result = result;
+		_last_response = _xfer_response;
+		_xfer_response = NULL;
+		}
+
+	if (_telemetry_sweep_mask & CMD_MASK(_xfer_cmd_idx))		// part of a telemetry sweep?
+		{
+		_telemetry_sweep_mask &= ~CMD_MASK(_xfer_cmd_idx);	// done with this one, successful or not
+		if (0 == _telemetry_sweep_mask)
+			{
+			telemetry.sweep_ms = millis();
+			telemetry.sweep_count++;
+			_telemetry_fresh = true;
+			}
+		}
+
+	return result;
+	}
+
+
+//---------------------------< I N T E R V A L _ S E T >------------------------------------------------------
+//
+// Set the minimum time between transactions to this supply.  Default is LCM300_CMD_INTERVAL_US; anything
+// shorter violates the datasheet communication interval and is only useful with other PMBus devices or
+// when testing.
+//
+
+void Systronix_LCM300::interval_set (uint32_t interval_us)
+	{
+	_interval_us = interval_us;
+	}
+
+
+//---------------------------< I N T E R V A L _ R E M A I N I N G >------------------------------------------
+//
+// Microseconds remaining in the communication interval that began at the end of the last transaction to this
+// supply; 0 when the supply may be addressed.
+//
+
+uint32_t Systronix_LCM300::interval_remaining (void)
+	{
+	uint32_t elapsed = micros() - _last_xfer_us;				// unsigned arithmetic handles micros() rollover
+
+	return (elapsed >= _interval_us) ? 0 : (_interval_us - elapsed);
+	}
+
+
+//---------------------------< I N T E R V A L _ W A I T >----------------------------------------------------
+//
+// Blocking wait for whatever remains of the communication interval.
+//
+
+void Systronix_LCM300::interval_wait (void)
+	{
+	uint32_t remaining = interval_remaining();
+
+	if (remaining)
+		delayMicroseconds (remaining);
+	}
+
+
+//---------------------------< T E L E M E T R Y _ S E T >----------------------------------------------------
+//
+// mask is CMD_MASK() bits of the commands that make up a sweep; only those commands with a field in the telemetry
+// struct are useful.  period_ms is the time from the start of one sweep to the start of the next.  A sweep in
+// progress is finished with the old mask.
+//
+
+void Systronix_LCM300::telemetry_set (uint32_t mask, uint32_t period_ms)
+	{
+	_telemetry_mask = mask & (CMD_MASK(CMD_ARRAY_SIZE) - 1);
+	_telemetry_period_ms = period_ms;
+	}
+
+
+//---------------------------< T E L E M E T R Y _ S C H E D U L E >------------------------------------------
+//
+// If no sweep is in progress and a period has elapsed since the last one started, queue the sweep commands.  Also
+// queues the fault monitor's STATUS_WORD poll and scheduled commands when they are due.  Used by poll_telemetry() and
+// Systronix_LCM300_bus::poll_telemetry(); nothing here touches the bus.
+//
+// @return SUCCESS when a sweep was queued, LCM300_PENDING when it is not yet time or a sweep is in progress,
+// ABSENT when the device does not exist
+//
+
+uint8_t Systronix_LCM300::telemetry_schedule (void)
+	{
+	if (!error.exists)
+		return ABSENT;
+
+	fault_schedule ();
+	schedule_queue ();
+
+	if (_telemetry_sweep_mask)										// sweep in progress
+		return LCM300_PENDING;
+
+	if (_telemetry_started && ((millis() - _telemetry_start_ms) < _telemetry_period_ms))
+		return LCM300_PENDING;										// not time yet
+
+	_telemetry_start_ms = millis();
+	_telemetry_started = true;
+	_telemetry_sweep_mask = _telemetry_mask;
+	command_queue_mask (_telemetry_mask);
+	return SUCCESS;
+	}
+
+
+//---------------------------< P O L L _ T E L E M E T R Y >--------------------------------------------------
+//
+// Call from loop() on an instance that is not registered with a Systronix_LCM300_bus (use
+// Systronix_LCM300_bus::poll_telemetry() for those).  Starts a sweep once per period and reads one command per
+// call as the communication interval allows.  Never blocks.  Consumers read the snapshot with snapshot() at any
+// time; only the sweep itself touches the bus.
+//
+// @return SUCCESS once when a sweep completes, ABSENT when the device does not exist, else LCM300_PENDING
+//
+
+uint8_t Systronix_LCM300::poll_telemetry (void)
+	{
+	if (ABSENT == telemetry_schedule ())
+		return ABSENT;
+
+	command_service ();
+
+	if (_telemetry_fresh)
+		{
+		_telemetry_fresh = false;
+		return SUCCESS;
+		}
+	return LCM300_PENDING;
+	}
+
+
+//---------------------------< S N A P S H O T >--------------------------------------------------------------
+
+const Systronix_LCM300::telemetry_t& Systronix_LCM300::snapshot (void)
+	{
+	return telemetry;
+	}
+
+
+//---------------------------< T E L E M E T R Y _ A G E >----------------------------------------------------
+//
+// milliseconds since the telemetry field for cmd_idx was last read successfully; UINT32_MAX if it never has been
+// or if cmd_idx has no telemetry field.
+//
+
+uint32_t Systronix_LCM300::telemetry_age (int cmd_idx)
+	{
+	int8_t	field = telemetry_field (cmd_idx);
+
+	if ((0 > field) || !(telemetry.valid & CMD_MASK(cmd_idx)))
+		return UINT32_MAX;
+
+	return millis() - telemetry.read_ms[field];
+	}
+
+
+//---------------------------< T E L E M E T R Y _ F I E L D >------------------------------------------------
+//
+// telemetry.read_ms[] index for cmd_idx; -1 when the command has no telemetry field
+//
+
+int8_t Systronix_LCM300::telemetry_field (int cmd_idx)
+	{
+	switch (cmd_idx)
+		{
+		case READ_VOUT_CMD:				return TELEM_VOUT;
+		case READ_IOUT_CMD:				return TELEM_IOUT;
+		case READ_POUT_CMD:				return TELEM_POUT;
+		case READ_TEMPERATURE_2_CMD:	return TELEM_TEMP_2;
+		case READ_FAN_SPEED_CMD:		return TELEM_FAN_SPEED;
+		case STATUS_BYTE_CMD:			return TELEM_STATUS_BYTE;
+		case STATUS_WORD_CMD:			return TELEM_STATUS_WORD;
+		case STATUS_VOUT_CMD:			return TELEM_STATUS_VOUT;
+		case STATUS_IOUT_CMD:			return TELEM_STATUS_IOUT;
+		case STATUS_TEMP_CMD:			return TELEM_STATUS_TEMP;
+		default:						return -1;
+		}
+	}
+
+
+//---------------------------< T E L E M E T R Y _ C A P T U R E >--------------------------------------------
+//
+// Called for every successful read.  When the command has a telemetry field, decode the response into it and
+// timestamp it.
+//
+
+void Systronix_LCM300::telemetry_capture (void)
+	{
+	int8_t	field = telemetry_field (_xfer_cmd_idx);
+
+	if (0 > field)
+		return;
+
+	switch (field)
+		{
+		case TELEM_VOUT:			telemetry.vout = raw_voltage_to_float (_xfer_data->as_word);			break;
+		case TELEM_IOUT:			telemetry.iout = pmbus_literal_to_float (_xfer_data->as_word);		break;
+		case TELEM_POUT:			telemetry.pout = pmbus_literal_to_float (_xfer_data->as_word);		break;
+		case TELEM_TEMP_2:			telemetry.temperature_2 = pmbus_literal_to_float (_xfer_data->as_word);	break;
+		case TELEM_FAN_SPEED:		telemetry.fan_speed = _xfer_data->as_word;							break;
+		case TELEM_STATUS_BYTE:		telemetry.status_byte = _xfer_data->as_byte;							break;
+		case TELEM_STATUS_WORD:										// the low byte is STATUS_BYTE
+			telemetry.status_word = _xfer_data->as_word;
+			telemetry.status_byte = _xfer_data->as_byte;
+			telemetry.read_ms[TELEM_STATUS_BYTE] = millis();
+			telemetry.valid |= CMD_MASK(STATUS_BYTE_CMD);
+			break;
+		case TELEM_STATUS_VOUT:		telemetry.status_vout = _xfer_data->as_byte;							break;
+		case TELEM_STATUS_IOUT:		telemetry.status_iout = _xfer_data->as_byte;							break;
+		case TELEM_STATUS_TEMP:		telemetry.status_temp = _xfer_data->as_byte;							break;
+		}
+
+	telemetry.read_ms[field] = millis();
+	telemetry.valid |= CMD_MASK(_xfer_cmd_idx);
+	}
+
+
+//---------------------------< R A W _ V O L T A G E _ T O _ F L O A T >--------------------------------------
+//
+// Voltage measurements appear to be rendered in a different form from all other linear measurements reported
+// by the LCM300.  These measurements use a separate exponent read from the LCM300 with the VOUT_MODE_CMD (0x20).
+//
+// _linear_exponent is set by init() and is simply a sign-extended version of the raw value returned by the
+// VOUT_MODE_CMD (0x20).  _vout_scale, 2^_linear_exponent, is set at the same time.
+//
+// result = mantissa * 2.0^exponent
+//
+// This function assumes that _linear_exponent has been set to a valid value before this function is called.
+// should not normally be an issue because _linear_exponent is set by init().
+//
+
+float Systronix_LCM300::raw_voltage_to_float (uint16_t volt_raw)
+	{
+	return (float)volt_raw * _vout_scale;
+	}
+
+
+//---------------------------< P M B U S _ L I T E R A L _ T O _ F L O A T >----------------------------------
+//
+// PMbus literal values are 16-bit values where:
+//		[15..11]	signed 2's complement exponent
+//		[10..0]		signed 2's complement mantissa
+// to calculate float value, sign extend the mantissa.  The exponent bits index exp2_table[] directly so need no
+// sign extension.
+// result = mantissa * 2.0^exponent
+//
+
+float Systronix_LCM300::pmbus_literal_to_float (uint16_t literal_raw)
+	{
+	int16_t		mantissa = (int16_t)(literal_raw << 5) >> 5;								// sign extend the 11-bit mantissa
+
+	return (float)mantissa * exp2_table[literal_raw >> 11];
+	}
+
+
+//---------------------------< R A W _ V O L T A G E _ T O _ M I L L I >--------------------------------------
+//
+// Integer-only version of raw_voltage_to_float() for callers that never need floats: millivolts, rounded to
+// nearest.
+//
+
+int32_t Systronix_LCM300::raw_voltage_to_milli (uint16_t volt_raw)
+	{
+	return milli_shift ((int32_t)volt_raw * 1000, _linear_exponent);			// fits: 65535 * 1000 < 2^31
+	}
+
+
+//---------------------------< P M B U S _ L I T E R A L _ T O _ M I L L I >----------------------------------
+//
+// Integer-only version of pmbus_literal_to_float(): the value * 1000, rounded to nearest, so amps become
+// milliamps, watts milliwatts, degrees millidegrees.  Saturates at INT32_MIN / INT32_MAX, reached only for
+// exponents > 10 which the LCM300 doesn't use.
+//
+
+int32_t Systronix_LCM300::pmbus_literal_to_milli (uint16_t literal_raw)
+	{
+	return milli_shift ((int32_t)((int16_t)(literal_raw << 5) >> 5) * 1000,	// sign extend the mantissa, scale
+		(int16_t)literal_raw >> 11);											// sign extend the exponent
+	}
+
+
+//---------------------------< M I L L I _ S H I F T >--------------------------------------------------------
+//
+// milli * 2^exponent, rounded to nearest, saturated to int32_t.  A shift for negative exponents; a multiply by
+// 2^exponent for positive ones, in 64 bits so it can't overflow (a left shift of a negative value is undefined).
+//
+
+int32_t Systronix_LCM300::milli_shift (int32_t milli, int8_t exponent)
+	{
+	int64_t	result;
+
+	if (0 > exponent)
+		return (int32_t)(((int64_t)milli + ((int64_t)1 << (-exponent - 1))) >> -exponent);	// round then shift
+
+	result = (int64_t)milli * ((int64_t)1 << exponent);
+	if (INT32_MAX < result)
+		return INT32_MAX;
+	if (INT32_MIN > result)
+		return INT32_MIN;
+	return (int32_t)result;
+	}
+
+
+//---------------------------< P M B U S _ A V E R A G E _ P O W E R >----------------------------------------
+//
+// Calculate average power.  From PMBus Power System Mgt Protocol Specification 1.2 part II section 10.13 page 87,
+// this calculation:
+//		average_power = (energy_count - last_energy _count) / (sample_count - last_sample_count)
+//
+// where energy_count is the result from this equation:
+//
+//	energy_count = rollover_count * maximum_direct_format_value + accumulator_value
+//		where:
+//			coefficients: m=1, b=0, R=0
+//			Ymax = 2^15-1 = 32767
+//			maximum_direct_format_value = (mYmax + b) * 10^R = (1Ymax + 0) * 10^R = (1 * 32767 + 0) * 10^0 = 32767
+//
+// this function does all maintenance of the eout_data struct.
+//
+// Frames are read a byte at a time, never through wider pointer casts, so they may sit at any alignment.
+// eout_average_power() does the work on any captured 7-byte frame; pmbus_average_power() is the old interface
+// and must be called directly after a call to command_read (READ_EOUT_CMD).
+//
+// Accumulator:  the accumulator value is believed to be in PMBus direct format event though the 1v5 data sheet
+// indicates that the READ_EOUT command returns 2 bytes in linear format.  Treating accumulator as if it is a
+// PMBus linear value produces irrational results (often negative power) which indicates that accumulator cannot
+// be PMBus linear.  The max value for accumulator in PMBus direct format is 32767 given the coefficients stated
+// in the data sheet m=1, b=0, R=0.
+//
+// When accumulator overflows, rollover_counter is incremented (this too may rollover at rc = 255), so energy_count
+// wraps at 256 * 32767; sample_count wraps at 2^24.  Differences are taken modulo those, which is right as long as
+// neither wrapped more than once between reads (see energy_update() for when that can't be ruled out).
+//
+
+void Systronix_LCM300::pmbus_average_power (void)
+	{
+	eout_average_power ((const uint8_t*)cmd_response.as_array);
+	}
+
+
+//---------------------------< E O U T _ A V E R A G E _ P O W E R >------------------------------------------
+//
+// pmbus_average_power() for a READ_EOUT frame (length byte and six data bytes, as read) captured earlier, e.g. by
+// command_start() / command_poll() or the bus scheduler.  Frames from one supply must be given in the order read.
+//
+// @return SUCCESS, FAIL when the frame is not a READ_EOUT frame or no samples were taken since the last one
+// (eout_data.average_power is then unchanged)
+//
+
+uint8_t Systronix_LCM300::eout_average_power (const uint8_t* frame)
+	{
+	uint32_t	energy_delta;
+	uint32_t	sample_delta;
+
+	if (SUCCESS != eout_parse (frame, &eout_data.energy_count, &eout_data.sample_count))
+		return FAIL;
+
+	eout_data.payload_length = frame[0];
+	eout_data.accumulator = frame[1] | (frame[2] << 8);
+	eout_data.rollover_count = frame[3];
+
+	energy_delta = (eout_data.energy_count + LCM300_EOUT_COUNTER_MOD - eout_data.last_energy_count) % LCM300_EOUT_COUNTER_MOD;
+	sample_delta = (eout_data.sample_count - eout_data.last_sample_count) & (LCM300_EOUT_SAMPLES_MOD - 1);
+
+	eout_data.last_energy_count = eout_data.energy_count;	// save new 'lasts'
+	eout_data.last_sample_count = eout_data.sample_count;
+	eout_data.last_rollover_count = eout_data.rollover_count;
+
+	if (0 == sample_delta)
+		return FAIL;
+
+	eout_data.average_power = energy_delta / sample_delta;	// calculate average power
+	return SUCCESS;
+	}
+
+
+//---------------------------< E O U T _ P A R S E >----------------------------------------------------------
+//
+// Pull the counters out of a READ_EOUT frame: energy_count = rollover_count * 32767 + accumulator, and the 24-bit
+// sample_count (a PEC byte after the frame is not part of it).
+//
+// @return SUCCESS, FAIL when the length byte is not 6
+//
+
+uint8_t Systronix_LCM300::eout_parse (const uint8_t* frame, uint32_t* energy_count, uint32_t* sample_count)
+	{
+	if ((EOUT - 1) != frame[0])
+		return FAIL;
+
+	*energy_count = (uint32_t)frame[3] * LCM300_EOUT_ACC_MAX + (frame[1] | ((uint32_t)frame[2] << 8));
+	*sample_count = frame[4] | ((uint32_t)frame[5] << 8) | ((uint32_t)frame[6] << 16);
+	return SUCCESS;
+	}
+
+
+//---------------------------< E N E R G Y _ U P D A T E >----------------------------------------------------
+//
+// Lifetime energy meter.  pmbus_average_power() handles at most one wrap of the rollover counter and none of
+// the sample counter, so slow or missed reads produce garbage.  This keeps 64-bit totals and works out how many
+// times each READ_EOUT counter wrapped since the last read, or says that it can't:
+//
+// The READ_EOUT energy counter, rollover_count * 32767 + accumulator, wraps at 256 * 32767 = 8388352 watt-samples;
+// the sample counter wraps at 2^24.  Between two reads the counters advanced by the difference modulo those plus
+// some unknown number of whole wraps.
+//
+//	sample counter wraps:	none possible when the elapsed time at the highest plausible sample rate is less than
+//							2^24 samples.  Otherwise the learned sample rate predicts the count; the one whole
+//							number of wraps within 10% of the prediction is used.  No learned rate, or no such
+//							number, is ambiguous.
+//	energy counter wraps:	power can't exceed power_max (energy_limits_set()), so the energy in the interval is at
+//							most samples * power_max.  If that leaves room for a wrap the interval is ambiguous.
+//							With the default 450W bound that means reading at least every 18640 samples.
+//
+// Ambiguous intervals are not added to energy_mws; their time goes into gap_ms, pout watts times that time goes
+// into gap_estimate_mws (none when pout is negative: not known), and the meter starts over from the current
+// reading.  Milliwatt-seconds for an interval are energy / samples (average watts) times elapsed milliseconds.
+//
+// Called for every successful READ_EOUT read, into energy, with telemetry.pout as it was then.  energy_update
+// (meter, frame, ms, pout) does the same for frames captured earlier (response_t data and ms) and processed
+// later, into a meter of your own, zeroed to start: every frame read has already been counted in energy, so
+// feeding one to energy again would count it twice.  pout is the Pout of the frame's supply when the frame was
+// read; nothing of this instance's but the energy_limits_set() bounds is used, so any instance can do the
+// work.  Frames must be given in the order read; the same frames and Pouts give meter the same totals as energy.
+//
+// @return SUCCESS when the interval was accounted, FAIL when it was ambiguous or frame is not a READ_EOUT frame,
+// LCM300_PENDING for the first read (nothing to compare with)
+//
+
+uint8_t Systronix_LCM300::energy_update (void)
+	{
+	return energy_update (energy, (const uint8_t*)cmd_response.as_array, millis(),
+		(telemetry.valid & CMD_MASK(READ_POUT_CMD)) ? telemetry.pout : -1);
+	}
+
+uint8_t Systronix_LCM300::energy_update (energy_t& meter, const uint8_t* frame, uint32_t now, float pout)
+	{
+	uint32_t	counter;
+	uint32_t	sample_count;
+	uint32_t	elapsed_ms;
+	uint32_t	energy_delta;
+	uint64_t	sample_delta;
+	float		expected;
+	float		wraps;
+	bool		ambiguous = false;
+
+	if (SUCCESS != eout_parse (frame, &counter, &sample_count))
+		return FAIL;
+
+	if (!meter.baseline)
+		{
+		meter.baseline = true;
+		meter.last_counter = counter;
+		meter.last_samples = sample_count;
+		meter.last_ms = now;
+		return LCM300_PENDING;
+		}
+
+	elapsed_ms = now - meter.last_ms;
+	energy_delta = (counter + LCM300_EOUT_COUNTER_MOD - meter.last_counter) % LCM300_EOUT_COUNTER_MOD;
+	sample_delta = (sample_count - meter.last_samples) & (LCM300_EOUT_SAMPLES_MOD - 1);
+
+	if (((float)elapsed_ms * _energy_rate_max / 1000) >= LCM300_EOUT_SAMPLES_MOD)	// sample counter may have wrapped
+		{
+		expected = (float)elapsed_ms * meter.sample_rate / 1000;
+		wraps = roundf ((expected - sample_delta) / LCM300_EOUT_SAMPLES_MOD);
+		if ((0 == meter.sample_rate) || (0 > wraps))
+			ambiguous = true;
+		else
+			{
+			sample_delta += (uint64_t)wraps * LCM300_EOUT_SAMPLES_MOD;
+			if (fabsf ((float)sample_delta - expected) > (expected / 10))
+				ambiguous = true;						// prediction too far off; supply reset?
+			}
+		}
+	else if (meter.sample_rate && (elapsed_ms >= 1000) &&
+			((float)sample_delta < (float)elapsed_ms * meter.sample_rate / 2000))
+		ambiguous = true;								// far fewer samples than there should be; supply reset?
+
+	if (!ambiguous && (0 == sample_delta))
+		ambiguous = (0 != energy_delta);				// energy without samples can't be right
+
+	if (!ambiguous && ((float)sample_delta * _energy_power_max) >= ((float)energy_delta + LCM300_EOUT_COUNTER_MOD))
+		ambiguous = true;								// energy counter could have wrapped
+
+	if ((float)sample_delta * _energy_power_max < (float)energy_delta)
+		ambiguous = true;								// more energy than possible; supply reset?
+
+	if (ambiguous)
+		{
+		meter.ambiguous_count++;
+		meter.gap_ms += elapsed_ms;
+		if (0 <= pout)
+			meter.gap_estimate_mws += (uint64_t)(pout * elapsed_ms);
+		}
+	else if (sample_delta)
+		{
+		meter.energy_raw += energy_delta;
+		meter.samples += sample_delta;
+		meter.energy_mws += (uint64_t)energy_delta * elapsed_ms / sample_delta;
+		meter.average_power = (float)energy_delta / sample_delta;
+		meter.intervals++;
+
+		if (500 <= elapsed_ms)							// learn the sample rate from intervals long enough to be accurate
+			{
+			expected = (float)sample_delta * 1000 / elapsed_ms;
+			meter.sample_rate = meter.sample_rate ? (0.9f * meter.sample_rate + 0.1f * expected) : expected;
+			}
+		}
+
+	meter.last_counter = counter;
+	meter.last_samples = sample_count;
+	meter.last_ms = now;
+	return ambiguous ? FAIL : SUCCESS;
+	}
+
+
+//---------------------------< E N E R G Y _ L I M I T S _ S E T >--------------------------------------------
+//
+// power_max: watts the supply can't exceed; sets how long reads can be apart before an energy counter wrap can't
+// be ruled out (256 * 32767 / power_max samples).  rate_max: samples/sec the sample counter can't exceed; sets
+// how long before a sample counter wrap needs the learned rate to resolve.  Tighter bounds, longer gaps.
+//
+
+void Systronix_LCM300::energy_limits_set (float power_max, float rate_max)
+	{
+	_energy_power_max = power_max;
+	_energy_rate_max = rate_max;
+	}
+
+
+//---------------------------< E N E R G Y _ S A V E >--------------------------------------------------------
+//
+// Copy the lifetime totals into store, with a check byte, for the caller to keep in EEPROM, flash, etc.  The
+// counter baseline is not saved: the interval across a reboot can't be known.
+//
+
+void Systronix_LCM300::energy_save (energy_store_t* store)
+	{
+	memset (store, 0, sizeof(*store));					// no stray padding bytes in the crc
+	store->magic = LCM300_ENERGY_MAGIC;
+	store->energy_mws = energy.energy_mws;
+	store->energy_raw = energy.energy_raw;
+	store->samples = energy.samples;
+	store->gap_estimate_mws = energy.gap_estimate_mws;
+	store->gap_ms = energy.gap_ms;
+	store->intervals = energy.intervals;
+	store->ambiguous_count = energy.ambiguous_count;
+	store->sample_rate = energy.sample_rate;
+	store->crc = energy_crc (store);
+	}
+
+
+//---------------------------< E N E R G Y _ R E S T O R E >--------------------------------------------------
+//
+// Restore totals saved by energy_save().  The next READ_EOUT read sets a new baseline.
+// @return SUCCESS, or FAIL when store is not a valid energy_save() image (nothing is changed)
+//
+
+uint8_t Systronix_LCM300::energy_restore (const energy_store_t* store)
+	{
+	if ((LCM300_ENERGY_MAGIC != store->magic) || (energy_crc (store) != store->crc))
+		return FAIL;
+
+	memset (&energy, 0, sizeof(energy));
+	energy.energy_mws = store->energy_mws;
+	energy.energy_raw = store->energy_raw;
+	energy.samples = store->samples;
+	energy.gap_estimate_mws = store->gap_estimate_mws;
+	energy.gap_ms = store->gap_ms;
+	energy.intervals = store->intervals;
+	energy.ambiguous_count = store->ambiguous_count;
+	energy.sample_rate = store->sample_rate;
+	return SUCCESS;
+	}
+
+
+//---------------------------< E N E R G Y _ C R C >----------------------------------------------------------
+
+uint8_t Systronix_LCM300::energy_crc (const energy_store_t* store)
+	{
+	return pec_crc8 (0, (const uint8_t*)store, offsetof (energy_store_t, crc));
+	}
+
+
+//---------------------------< F A U L T _ M O N I T O R _ S E T >--------------------------------------------
+//
+// The fault monitor watches STATUS_WORD, a summary of everything, and reads the detail registers STATUS_VOUT,
+// STATUS_IOUT and STATUS_TEMP only when their summary bits in STATUS_WORD change.  Nearly all of the time that is
+// one status read instead of five.  STATUS_BYTE is the low byte of STATUS_WORD so is never read.
+//
+// Every STATUS_WORD read feeds the monitor, whoever asked for it; the default telemetry sweep includes it.
+// period_ms > 0 also queues a STATUS_WORD read of its own every period_ms (see fault_schedule()), for faster
+// fault detection than the telemetry period gives.  0 stops those.
+//
+// fault_cb, when not NULL, is called with each fault code (LCM300_FAULT_...) as its bit changes: asserted true
+// when it sets, false when it clears.  Detail bits clear when their summary bits do, without a read.
+//
+// clear_policy LCM300_FAULT_CLEAR_AUTO sends CLEAR_FAULTS once the details of a newly set fault have been read,
+// so latched faults that have gone away are reported as cleared at the next STATUS_WORD read.  A condition that
+// persists sets its bit again and is not reported or cleared again.
+//
+
+void Systronix_LCM300::fault_monitor_set (uint32_t period_ms, uint8_t clear_policy, lcm300_fault_cb_t fault_cb)
+	{
+	_fault_period_ms = period_ms;
+	_fault_policy = clear_policy;
+	_fault_cb = fault_cb;
+	}
+
+
+//---------------------------< F A U L T _ S C H E D U L E >--------------------------------------------------
+//
+// Queue a STATUS_WORD read when the fault monitor period has elapsed since the last one.  Called by
+// telemetry_schedule(); nothing here touches the bus.
+//
+// @return SUCCESS when the read was queued, LCM300_PENDING when it is not time or there is no period, ABSENT when
+// the device does not exist
+//
+
+uint8_t Systronix_LCM300::fault_schedule (void)
+	{
+	if (!error.exists)
+		return ABSENT;
+
+	if (!_fault_period_ms || (_queue_mask & CMD_MASK(STATUS_WORD_CMD)))
+		return LCM300_PENDING;
+
+	if (_fault_started && ((millis() - _fault_read_ms) < _fault_period_ms))
+		return LCM300_PENDING;
+
+	_fault_read_ms = millis();								// so a failed read is retried a period later, not at once
+	_fault_started = true;
+	command_queue (STATUS_WORD_CMD);
+	return SUCCESS;
+	}
+
+
+//---------------------------< F A U L T _ C A P T U R E >----------------------------------------------------
+//
+// Called for every successful read.  For STATUS_WORD: report the bits that changed, and for each detail register
+// whose summary bits changed, queue a read of it when they are now set or clear it when they are not.  For the
+// detail registers: report the bits that changed.
+//
+
+void Systronix_LCM300::fault_capture (void)
+	{
+	uint16_t	word;
+	uint16_t	old_word;
+	uint8_t		reg;
+	uint8_t*	detail;
+
+	switch (_xfer_cmd_idx)
+		{
+		case STATUS_WORD_CMD:
+			word = _xfer_data->as_word;
+			old_word = faults.status_word;
+			_fault_read_ms = millis();
+			_fault_started = true;
+			if (word == old_word)
+				return;										// the usual case
+
+			faults.status_word = word;
+			fault_events (LCM300_FAULT_REG_WORD, old_word, word);
+			fault_detail (LCM300_FAULT_VOUT_SUMMARY, STATUS_VOUT_CMD, LCM300_FAULT_REG_VOUT, old_word ^ word);
+			fault_detail (LCM300_FAULT_IOUT_SUMMARY, STATUS_IOUT_CMD, LCM300_FAULT_REG_IOUT, old_word ^ word);
+			fault_detail (LCM300_FAULT_TEMP_SUMMARY, STATUS_TEMP_CMD, LCM300_FAULT_REG_TEMP, old_word ^ word);
+
+			if ((LCM300_FAULT_CLEAR_AUTO == _fault_policy) && (word & ~old_word))
+				_fault_clear_pending = true;				// something new; clear once the details are in
+			return;
+
+		case STATUS_VOUT_CMD:	reg = LCM300_FAULT_REG_VOUT;	detail = &faults.status_vout;	break;
+		case STATUS_IOUT_CMD:	reg = LCM300_FAULT_REG_IOUT;	detail = &faults.status_iout;	break;
+		case STATUS_TEMP_CMD:	reg = LCM300_FAULT_REG_TEMP;	detail = &faults.status_temp;	break;
+		default:				return;
+		}
+
+	if (*detail == _xfer_data->as_byte)
+		return;
+
+	if ((LCM300_FAULT_CLEAR_AUTO == _fault_policy) && (_xfer_data->as_byte & ~*detail))
+		_fault_clear_pending = true;
+	fault_events (reg, *detail, _xfer_data->as_byte);
+	*detail = _xfer_data->as_byte;
+	}
+
+
+//---------------------------< F A U L T _ D E T A I L >------------------------------------------------------
+//
+// STATUS_WORD summary bits for the detail register cmd_idx changed: read it if they are now set, else it is 0.
+//
+
+void Systronix_LCM300::fault_detail (uint16_t summary, int cmd_idx, uint8_t reg, uint16_t changed)
+	{
+	uint8_t*	detail;
+	int8_t		field = telemetry_field (cmd_idx);
+
+	if (!(changed & summary))
+		return;
+
+	if (faults.status_word & summary)
+		{
+		command_queue (cmd_idx);
+		faults.drill_count++;
+		return;
+		}
+
+	switch (reg)
+		{
+		case LCM300_FAULT_REG_VOUT:		detail = &faults.status_vout;	telemetry.status_vout = 0;	break;
+		case LCM300_FAULT_REG_IOUT:		detail = &faults.status_iout;	telemetry.status_iout = 0;	break;
+		default:						detail = &faults.status_temp;	telemetry.status_temp = 0;	break;
+		}
+	telemetry.read_ms[field] = millis();					// known from this STATUS_WORD read
+	telemetry.valid |= CMD_MASK(cmd_idx);
+
+	fault_events (reg, *detail, 0);
+	*detail = 0;
+	}
+
+
+//---------------------------< F A U L T _ E V E N T S >------------------------------------------------------
+//
+// One callback per changed bit of a status register
+//
+
+void Systronix_LCM300::fault_events (uint8_t reg, uint16_t old_bits, uint16_t new_bits)
+	{
+	uint16_t	changed = old_bits ^ new_bits;
+	uint8_t		bit;
+
+	for (bit = 0; changed; bit++, changed >>= 1)
+		{
+		if (!(changed & 1))
+			continue;
+
+		faults.event_count++;
+		faults.change_ms = millis();
+		if (_fault_cb)
+			_fault_cb (this, LCM300_FAULT_CODE(reg, bit), (new_bits >> bit) & 1);
+		}
+	}
+
+
+//---------------------------< F A U L T _ A C T I V E >------------------------------------------------------
+
+bool Systronix_LCM300::fault_active (uint16_t fault)
+	{
+	uint8_t	bit = fault & 0xFF;
+
+	switch (fault >> 8)
+		{
+		case LCM300_FAULT_REG_WORD:		return (faults.status_word >> bit) & 1;
+		case LCM300_FAULT_REG_VOUT:		return (faults.status_vout >> bit) & 1;
+		case LCM300_FAULT_REG_IOUT:		return (faults.status_iout >> bit) & 1;
+		case LCM300_FAULT_REG_TEMP:		return (faults.status_temp >> bit) & 1;
+		default:						return false;
+		}
+	}
+
+
+//---------------------------< F A U L T _ N A M E >----------------------------------------------------------
+//
+// PMBus name of a fault code; "?" for codes that aren't faults (reserved STATUS_TEMP bits for instance)
+//
+
+const char* Systronix_LCM300::fault_name (uint16_t fault)
+	{
+	static const char*	word_name[16] = {"NONE_OF_THE_ABOVE", "CML", "TEMPERATURE", "VIN_UV_FAULT", "IOUT_OC_FAULT",
+							"VOUT_OV_FAULT", "OFF", "BUSY", "UNKNOWN", "OTHER", "FANS", "POWER_GOOD#", "MFR_SPECIFIC",
+							"INPUT", "IOUT/POUT", "VOUT"};
+	static const char*	vout_name[8] = {"VOUT_TRACKING_ERROR", "TOFF_MAX_WARNING", "TON_MAX_FAULT", "VOUT_MAX_WARNING",
+							"VOUT_UV_FAULT", "VOUT_UV_WARNING", "VOUT_OV_WARNING", "VOUT_OV_FAULT"};
+	static const char*	iout_name[8] = {"POUT_OP_WARNING", "POUT_OP_FAULT", "POWER_LIMIT_MODE", "CURRENT_SHARE_FAULT",
+							"IOUT_UC_FAULT", "IOUT_OC_WARNING", "IOUT_OC_LV_FAULT", "IOUT_OC_FAULT"};
+	static const char*	temp_name[4] = {"UT_FAULT", "UT_WARNING", "OT_WARNING", "OT_FAULT"};
+	uint8_t	bit = fault & 0xFF;
+
+	switch (fault >> 8)
+		{
+		case LCM300_FAULT_REG_WORD:		return (16 > bit) ? word_name[bit] : "?";
+		case LCM300_FAULT_REG_VOUT:		return (8 > bit) ? vout_name[bit] : "?";
+		case LCM300_FAULT_REG_IOUT:		return (8 > bit) ? iout_name[bit] : "?";
+		case LCM300_FAULT_REG_TEMP:		return ((4 <= bit) && (8 > bit)) ? temp_name[bit - 4] : "?";
+		default:						return "?";
+		}
+	}
+
+
+//---------------------------< F A U L T _ C L E A R _ P E N D I N G >----------------------------------------
+
+bool Systronix_LCM300::fault_clear_pending (void)
+	{
+	return _fault_clear_pending;
+	}
+
+
+//---------------------------< F A U L T _ C L E A R _ S E R V I C E >----------------------------------------
+//
+// Send the CLEAR_FAULTS the auto clear policy asked for, once the detail reads it is waiting on are done and the
+// supply is free: no transaction in progress and the communication interval elapsed, so clear_faults_cmd() doesn't
+// wait.  Called by command_service() and Systronix_LCM300_bus::tick().
+//
+// @return SUCCESS when sent or nothing is pending, LCM300_PENDING when not yet, FAIL when the write failed (not
+// retried), ABSENT when the device does not exist
+//
+
+uint8_t Systronix_LCM300::fault_clear_service (void)
+	{
+	if (!_fault_clear_pending)
+		return SUCCESS;
+
+	if (!error.exists)
+		{
+		_fault_clear_pending = false;
+		return ABSENT;
+		}
+
+	if (command_busy() || interval_remaining() ||
+		(_queue_mask & (CMD_MASK(STATUS_VOUT_CMD) | CMD_MASK(STATUS_IOUT_CMD) | CMD_MASK(STATUS_TEMP_CMD))))
+		return LCM300_PENDING;
+
+	_fault_clear_pending = false;
+	if (SUCCESS != clear_faults_cmd())
+		return FAIL;
+
+	faults.clear_count++;
+	return SUCCESS;
+	}
+
+
+//---------------------------< S C H E D U L E _ S E T >------------------------------------------------------
+//
+// Give cmd_idx a schedule of its own, independent of the telemetry sweep: it is queued every period_ms, which
+// adapts between period_min_ms and period_max_ms.  After each read of a command with a telemetry value (Vout,
+// Iout, Pout, temperature, fan speed):
+//
+//	changed by more than tolerance since the last read, or near a limit		period halves, down to period_min_ms
+//	otherwise																period grows by a quarter, up to period_max_ms
+//
+// Near a limit is Iout above LCM300_SCHEDULE_NEAR_LIMIT of MFR_IOUT_MAX, or Vout within (1 - that) of half the
+// MFR_VOUT_MIN - MFR_VOUT_MAX range from either end.  A tolerance of 0, or period_min_ms == period_max_ms, is a
+// fixed period.  The period starts at period_min_ms and backs off from there.
+//
+// priority orders command_dequeue(): when several commands of this supply are queued, the highest goes first.
+// deadline_ms (0 = one period) is how late after falling due a read may be before it counts as a miss.
+// period_max_ms 0 removes the schedule.
+//
+// @return SUCCESS, or FAIL when cmd_idx is out of range, period_min_ms > period_max_ms, or all the
+// schedule_attach() slots are in use (or none are attached)
+//
+
+uint8_t Systronix_LCM300::schedule_set (int cmd_idx, uint32_t period_min_ms, uint32_t period_max_ms, uint8_t priority,
+	float tolerance, uint32_t deadline_ms)
+	{
+	schedule_t*	slot = NULL;
+	uint8_t		i;
+
+	if ((0 > cmd_idx) || (CMD_ARRAY_SIZE <= cmd_idx) || (period_min_ms > period_max_ms))
+		return FAIL;
+
+	for (i=0; i<_schedule_count; i++)
+		{
+		if (_schedule[i].period_max_ms && (cmd_idx == _schedule[i].cmd_idx))
+			slot = &_schedule[i];							// replace this one
+		}
+
+	if (0 == period_max_ms)									// remove
+		{
+		if (slot)
+			memset (slot, 0, sizeof(*slot));
+		return SUCCESS;
+		}
+
+	for (i=0; !slot && (i<_schedule_count); i++)
+		{
+		if (0 == _schedule[i].period_max_ms)
+			slot = &_schedule[i];
+		}
+	if (!slot)
+		return FAIL;
+
+	memset (slot, 0, sizeof(*slot));
+	slot->cmd_idx = cmd_idx;
+	slot->priority = priority;
+	slot->period_min_ms = period_min_ms ? period_min_ms : 1;
+	slot->period_max_ms = period_max_ms;
+	slot->period_ms = slot->period_min_ms;
+	slot->deadline_ms = deadline_ms;
+	slot->tolerance = tolerance;
+	slot->due_ms = millis();								// due now
+	return SUCCESS;
+	}
+
+
+//---------------------------< S C H E D U L E _ D E F A U L T >----------------------------------------------
+//
+// Replace the telemetry sweep with adaptive schedules: Iout and Pout, which follow the load, 100 ms - 2 s;
+// Vout 250 ms - 4 s; temperature and fan speed, which change slowly, 1 - 10 s; STATUS_WORD (the fault monitor) and
+// READ_EOUT (the energy meter) fixed at the telemetry period.  The snapshot stays current; poll_telemetry() no
+// longer reports completed sweeps.
+//
+// @return SUCCESS, or FAIL, with the sweep left as it was, when fewer than LCM300_SCHEDULE_DEFAULT_SLOTS are attached
+//
+
+uint8_t Systronix_LCM300::schedule_default (void)
+	{
+	if (LCM300_SCHEDULE_DEFAULT_SLOTS > _schedule_count)
+		return FAIL;
+
+	schedule_clear ();
+	schedule_set (STATUS_WORD_CMD, _telemetry_period_ms, _telemetry_period_ms, 4);
+	schedule_set (READ_IOUT_CMD, 100, 2000, 3, 0.1);		// amps
+	schedule_set (READ_POUT_CMD, 100, 2000, 3, 2.0);		// watts
+	schedule_set (READ_VOUT_CMD, 250, 4000, 2, 0.05);		// volts
+	schedule_set (READ_TEMPERATURE_2_CMD, 1000, 10000, 1, 0.5);	// degrees C
+	schedule_set (READ_FAN_SPEED_CMD, 1000, 10000, 1, 100);	// rpm
+	schedule_set (READ_EOUT_CMD, _telemetry_period_ms, _telemetry_period_ms, 0);
+	telemetry_set (0, _telemetry_period_ms);
+	return SUCCESS;
+	}
+
+
+//---------------------------< S C H E D U L E _ A T T A C H >------------------------------------------------
+//
+// Schedules live in the sketch, not in each instance: slots is an array of count schedule_t of your own
+// (LCM300_SCHEDULE_SLOTS is a good size), one per command with a schedule.  It is cleared here.  NULL removes all
+// schedules; without slots, schedule_set() fails and commands are dequeued lowest-numbered first.
+//
+// @return SUCCESS, or FAIL when slots is not NULL and count is 0
+//
+
+uint8_t Systronix_LCM300::schedule_attach (schedule_t* slots, uint8_t count)
+	{
+	if (slots && (0 == count))
+		return FAIL;
+
+	_schedule = slots;
+	_schedule_count = slots ? count : 0;
+	schedule_clear ();
+	return SUCCESS;
+	}
+
+
+//---------------------------< S C H E D U L E _ C L E A R >--------------------------------------------------
+
+void Systronix_LCM300::schedule_clear (void)
+	{
+	if (_schedule)
+		memset (_schedule, 0, _schedule_count * sizeof(schedule_t));
+	}
+
+
+//---------------------------< S C H E D U L E _ G E T >------------------------------------------------------
+
+const Systronix_LCM300::schedule_t* Systronix_LCM300::schedule_get (int cmd_idx)
+	{
+	for (uint8_t i=0; i<_schedule_count; i++)
+		{
+		if (_schedule[i].period_max_ms && (cmd_idx == _schedule[i].cmd_idx))
+			return &_schedule[i];
+		}
+	return NULL;
+	}
+
+
+//---------------------------< S C H E D U L E _ Q U E U E >--------------------------------------------------
+//
+// Queue every scheduled command that has fallen due and is not already waiting.  Called by telemetry_schedule();
+// nothing here touches the bus.
+//
+// @return SUCCESS when something was queued, LCM300_PENDING when nothing was due, ABSENT when the device does not
+// exist
+//
+
+uint8_t Systronix_LCM300::schedule_queue (void)
+	{
+	uint32_t	now = millis();
+	uint8_t		ret_val = LCM300_PENDING;
+
+	if (!error.exists)
+		return ABSENT;
+
+	for (uint8_t i=0; i<_schedule_count; i++)
+		{
+		if (!_schedule[i].period_max_ms || _schedule[i].queued || (0 > (int32_t)(now - _schedule[i].due_ms)))
+			continue;
+
+		_schedule[i].queued = true;
+		command_queue (_schedule[i].cmd_idx);
+		ret_val = SUCCESS;
+		}
+	return ret_val;
+	}
+
+
+//---------------------------< S C H E D U L E _ C A P T U R E >----------------------------------------------
+//
+// Called for every read, successful or not.  When the command has a schedule, keep its stats and, for a
+// successful read, adapt its period and set when it is next due.
+//
+
+void Systronix_LCM300::schedule_capture (bool success)
+	{
+	schedule_t*	slot = NULL;
+	uint32_t	now = millis();
+	uint32_t	late;
+	int8_t		field;
+	float		value;
+
+	for (uint8_t i=0; !slot && (i<_schedule_count); i++)
+		{
+		if (_schedule[i].period_max_ms && (_xfer_cmd_idx == _schedule[i].cmd_idx))
+			slot = &_schedule[i];
+		}
+	if (!slot)
+		return;
+
+	if (!success)
+		{
+		slot->fail_count++;
+		if (slot->queued)									// try again after the shortest period
+			{
+			slot->queued = false;
+			slot->due_ms = now + slot->period_min_ms;
+			}
+		return;
+		}
+
+	if (slot->queued)										// a scheduled read; how late was it?
+		{
+		late = ((int32_t)(now - slot->due_ms) > 0) ? (now - slot->due_ms) : 0;
+		slot->late_sum_ms += late;
+		if (late > slot->late_max_ms)
+			slot->late_max_ms = late;
+		if (late > (slot->deadline_ms ? slot->deadline_ms : slot->period_ms))
+			slot->miss_count++;
+		slot->queued = false;
+		}
+	slot->read_count++;
+
+	field = telemetry_field (_xfer_cmd_idx);
+	if ((slot->tolerance > 0) && (slot->period_min_ms < slot->period_max_ms) && (0 <= field) && (TELEM_STATUS_BYTE > field))
+		{
+		switch (field)
+			{
+			case TELEM_VOUT:		value = telemetry.vout;				break;
+			case TELEM_IOUT:		value = telemetry.iout;				break;
+			case TELEM_POUT:		value = telemetry.pout;				break;
+			case TELEM_TEMP_2:		value = telemetry.temperature_2;	break;
+			default:				value = telemetry.fan_speed;		break;
+			}
+
+		if (((1 < slot->read_count) && (fabsf (value - slot->last_value) > slot->tolerance)) ||
+			schedule_near_limit (_xfer_cmd_idx, value))
+			{
+			if (slot->period_ms > slot->period_min_ms)
+				{
+				slot->period_ms = (slot->period_ms / 2 > slot->period_min_ms) ? slot->period_ms / 2 : slot->period_min_ms;
+				slot->speedup_count++;
+				}
+			}
+		else if (slot->period_ms < slot->period_max_ms)
+			{
+			slot->period_ms += slot->period_ms / 4 + 1;
+			if (slot->period_ms > slot->period_max_ms)
+				slot->period_ms = slot->period_max_ms;
+			slot->backoff_count++;
+			}
+		slot->last_value = value;
+		}
+
+	slot->due_ms = now + slot->period_ms;
+	}
+
+
+//---------------------------< S C H E D U L E _ N E A R _ L I M I T >----------------------------------------
+//
+// Iout near MFR_IOUT_MAX, or Vout near MFR_VOUT_MIN or MFR_VOUT_MAX; false until those limits have been read.
+//
+
+bool Systronix_LCM300::schedule_near_limit (int cmd_idx, float value)
+	{
+	float	middle;
+	float	half_range;
+
+	if ((READ_IOUT_CMD == cmd_idx) && (identity.valid & CMD_MASK(MFR_IOUT_MAX_CMD)))
+		return value >= (LCM300_SCHEDULE_NEAR_LIMIT * identity.mfr_iout_max);
+
+	if ((READ_VOUT_CMD == cmd_idx) && ((identity.valid & (CMD_MASK(MFR_VOUT_MIN_CMD) | CMD_MASK(MFR_VOUT_MAX_CMD))) ==
+		(CMD_MASK(MFR_VOUT_MIN_CMD) | CMD_MASK(MFR_VOUT_MAX_CMD))))
+		{
+		middle = (identity.mfr_vout_max + identity.mfr_vout_min) / 2;
+		half_range = (identity.mfr_vout_max - identity.mfr_vout_min) / 2;
+		return fabsf (value - middle) >= (LCM300_SCHEDULE_NEAR_LIMIT * half_range);
+		}
+
+	return false;
+	}
+
+
+//---------------------------< S T A T S _ A T T A C H >------------------------------------------------------
+//
+// Transaction instrumentation.  Every read and write is timed from the start of its command byte to the end of
+// its response (latency) and from command_start() to that command byte (wait: the communication interval and
+// time spent behind other supplies).  Counts, bytes, and latency min / sum / max per command, one latency
+// histogram, NAKs, timeouts, and short reads.  They are counted into a stats_t of the sketch's own, attached
+// with stats_attach(); Systronix_LCM300_bus::stats_reset() and utilization() cover the ones attached on a net.
+// Cost per transaction is three micros() and a few adds; none without stats attached or while
+// stats_enable (false), and none at all when the library is built with LCM300_INSTRUMENTATION 0, when the timing
+// hooks do nothing and the attached stats stay zero.
+//
+
+void Systronix_LCM300::stats_attach (stats_t* stats)
+	{
+	_stats = stats;
+	stats_reset ();
+#if LCM300_INSTRUMENTATION
+	_stats_start_us = _stats_bus_us = micros();				// a transaction already under way wasn't timed
+#endif
+	}
+
+
+const Systronix_LCM300::stats_t* Systronix_LCM300::stats_get (void)
+	{
+	return _stats;
+	}
+
+
+void Systronix_LCM300::stats_reset (void)
+	{
+	if (!_stats)
+		return;
+
+	memset (_stats, 0, sizeof(*_stats));
+#if LCM300_INSTRUMENTATION
+	_stats->clock_us = micros();
+#endif
+	}
+
+
+void Systronix_LCM300::stats_enable (bool enable)
+	{
+#if LCM300_INSTRUMENTATION
+	if (enable && !_stats_enabled)
+		_stats_start_us = _stats_bus_us = micros();			// a transaction already under way wasn't timed
+	_stats_enabled = enable;
+#else
+	(void)enable;
+#endif
+	}
+
+
+//---------------------------< S T A T S _ U T I L I Z A T I O N >--------------------------------------------
+//
+// Fraction of the time since stats_reset() that this supply had the bus.  Sum it over the supplies on one Wire
+// net (Systronix_LCM300_bus::utilization()) for the net's utilization.  The elapsed time is 64 bits, carried
+// past each micros() wrap (71.6 minutes) by the transactions in between; a supply left with no transactions and
+// no calls here for longer than that loses whole wraps.
+//
+
+float Systronix_LCM300::stats_utilization (void)
+	{
+#if LCM300_INSTRUMENTATION
+	uint32_t	now;
+
+	if (!_stats)
+		return 0;
+
+	now = micros();
+	_stats->elapsed_us += now - _stats->clock_us;
+	_stats->clock_us = now;
+	return _stats->elapsed_us ? (float)_stats->busy_us / _stats->elapsed_us : 0;
+#else
+	return 0;
+#endif
+	}
+
+
+#if LCM300_INSTRUMENTATION
+//---------------------------< S T A T S _ S T A R T ,   S T A T S _ B U S >----------------------------------
+
+void Systronix_LCM300::stats_start (void)
+	{
+	if (_stats && _stats_enabled)
+		_stats_start_us = micros();
+	}
+
+
+void Systronix_LCM300::stats_bus (void)
+	{
+	if (!_stats || !_stats_enabled)
+		return;
+
+	_stats_bus_us = micros();
+	_stats_bytes = (0 <= _xfer_cmd_idx) ? 1 + read_count (_xfer_cmd_idx) : 1;	// command byte and the response as requested
+	_stats->wait_us += _stats_bus_us - _stats_start_us;
+	}
+
+
+//---------------------------< S T A T S _ E N D ,   S T A T S _ W R I T E >----------------------------------
+//
+// Read or write complete.  A failed read counts the command byte only.
+//
+
+void Systronix_LCM300::stats_end (uint8_t result)
+	{
+	if (_stats && _stats_enabled)
+		stats_record (_stats->cmd[_xfer_cmd_idx], (SUCCESS == result) ? _stats_bytes : 1, result);
+	}
+
+
+void Systronix_LCM300::stats_write (uint8_t bytes, uint8_t result)
+	{
+	if (_stats && _stats_enabled)
+		stats_record (_stats->write, bytes, result);
+	}
+
+
+//---------------------------< S T A T S _ R E C O R D >------------------------------------------------------
+
+void Systronix_LCM300::stats_record (stats_cmd_t& entry, uint8_t bytes, uint8_t result)
+	{
+	uint32_t	latency = _last_xfer_us - _stats_bus_us;
+	uint32_t	bin = latency >> LCM300_STATS_BIN0_SHIFT;
+	uint8_t		status;
+
+	bin = bin ? (32 - __builtin_clz (bin)) : 0;				// log2 bins
+	if (LCM300_STATS_BINS <= bin)
+		bin = LCM300_STATS_BINS - 1;
+	_stats->histogram[bin]++;
+	_stats->busy_us += latency;
+	_stats->elapsed_us += _last_xfer_us - _stats->clock_us;	// keeps utilization's clock ahead of micros() wraps
+	_stats->clock_us = _last_xfer_us;
+
+	if ((0 == entry.count) || (latency < entry.latency_min_us))
+		entry.latency_min_us = latency;
+	if (latency > entry.latency_max_us)
+		entry.latency_max_us = latency;
+	entry.latency_sum_us += latency;
+	entry.bytes += bytes;
+	entry.count++;
+	if (SUCCESS != result)
+		{
+		entry.fail_count++;
+		status = _transport->status();
+		if ((I2C_ADDR_NAK == status) || (I2C_DATA_NAK == status))
+			_stats->nak_count++;
+		else if (I2C_TIMEOUT == status)
+			_stats->timeout_count++;
+		}
+	}
+
+#else	// LCM300_INSTRUMENTATION 0: declared all the same, so the class layout doesn't change
+
+void Systronix_LCM300::stats_start (void) {}
+void Systronix_LCM300::stats_bus (void) {}
+void Systronix_LCM300::stats_end (uint8_t) {}
+void Systronix_LCM300::stats_write (uint8_t, uint8_t) {}
+void Systronix_LCM300::stats_record (stats_cmd_t&, uint8_t, uint8_t) {}
+#endif
+
+
+//---------------------------< R E C O V E R Y _ S E T >------------------------------------------------------
+//
+// Retry and recovery policy for queued commands, those read by command_service() or Systronix_LCM300_bus;
+// command_read() and command_start() callers see every failure as before.
+//
+//	retries				a failed command is queued again up to this many times.  Before each retry the supply is
+//						held, nothing started, for retry_backoff_ms, doubling with each retry; other supplies on
+//						the bus carry on meanwhile.  Only the final result goes to the bus callback.
+//	offline				LCM300_OFFLINE_FAILS failed transactions in a row make the supply absent: its queue is
+//						discarded and its identity forgotten (it may be a different supply when it comes back).
+//	re-probe			while absent, VOUT_MODE is read every probe_min_ms at first, the wait doubling with each
+//						miss up to probe_max_ms.  When it answers it is present again and its identity is queued
+//						for reading; recovery.outage_ms is how long it was gone.  probe_max_ms 0: never re-probe.
+//	stuck bus			LCM300_STUCK_TIMEOUTS timeouts or lost arbitrations in a row reset the bus (reset_bus()).
+//
+// Defaults are LCM300_RETRIES, LCM300_RETRY_BACKOFF_MS, LCM300_PROBE_MIN_MS, LCM300_PROBE_MAX_MS.
+//
+
+void Systronix_LCM300::recovery_set (uint8_t retries, uint32_t retry_backoff_ms, uint32_t probe_min_ms, uint32_t probe_max_ms)
+	{
+	_retries = retries;
+	_retry_backoff_ms = retry_backoff_ms;
+	_probe_min_ms = probe_min_ms ? probe_min_ms : 1;
+	_probe_max_ms = (probe_max_ms && (probe_max_ms < _probe_min_ms)) ? _probe_min_ms : probe_max_ms;
+	_probe_ms = _probe_min_ms;
+	}
+
+
+//---------------------------< R E C O V E R Y _ R E S U L T >------------------------------------------------
+//
+// Called by the queue driver (command_service(), Systronix_LCM300_bus::tick()) with the result of each command it
+// started, once command_poll() has returned it.  Applies the recovery policy.
+//
+// @return result, or LCM300_PENDING when there is nothing to report yet: the command has been queued for a retry,
+// or this was a re-probe
+//
+
+uint8_t Systronix_LCM300::recovery_result (uint8_t result)
+	{
+	uint32_t	now = millis();
+
+	if ((I2C_TIMEOUT == _xfer_status) || (I2C_ARB_LOST == _xfer_status))
+		{
+		if (LCM300_STUCK_TIMEOUTS <= ++_stuck_streak)		// something is holding the bus
+			{
+			_stuck_streak = 0;
+			recovery.bus_reset_count++;
+			reset_bus ();
+			identity_refresh ();
+			}
+		}
+	else
+		_stuck_streak = 0;
+
+	if (_probing)
+		{
+		_probing = false;
+		if (SUCCESS == result)								// back
+			{
+			_fail_streak = 0;
+			_probe_ms = _probe_min_ms;
+			recovery.online_count++;
+			recovery.outage_ms = now - recovery.offline_ms;
+			identity_refresh ();
+			}
+		else												// still gone; wait longer next time
+			{
+			error.exists = false;
+			_probe_ms = (_probe_ms < _probe_max_ms / 2) ? 2 * _probe_ms : _probe_max_ms;
+			recovery_hold (_probe_ms);
+			}
+		return LCM300_PENDING;
+		}
+
+	if (SUCCESS == result)
+		{
+		_fail_streak = 0;
+		_retry[_xfer_cmd_idx] = 0;
+		return SUCCESS;
+		}
+
+	if (LCM300_OFFLINE_FAILS <= ++_fail_streak)
+		{
+		_retry[_xfer_cmd_idx] = 0;
+		if (_probe_max_ms)
+			{
+			recovery_offline ();
+			return FAIL;
+			}
+		}
+
+	if (_retry[_xfer_cmd_idx] < _retries)
+		{
+		recovery.retry_count++;
+		recovery_hold (_retry_backoff_ms << _retry[_xfer_cmd_idx]);
+		_retry[_xfer_cmd_idx]++;
+		command_queue (_xfer_cmd_idx);
+		return LCM300_PENDING;
+		}
+
+	_retry[_xfer_cmd_idx] = 0;
+	recovery.giveup_count++;
+	return FAIL;
+	}
+
+
+//---------------------------< R E C O V E R Y _ O F F L I N E >----------------------------------------------
+
+void Systronix_LCM300::recovery_offline (void)
+	{
+	error.exists = false;
+	command_queue_clear ();
+	memset (_retry, 0, sizeof(_retry));
+	identity_invalidate ();
+	_fail_streak = 0;
+	_probe_ms = _probe_min_ms;
+	recovery.offline_count++;
+	recovery.offline_ms = millis();
+	recovery_hold (_probe_ms);
+	}
+
+
+//---------------------------< R E C O V E R Y _ H O L D >----------------------------------------------------
+
+void Systronix_LCM300::recovery_hold (uint32_t ms)
+	{
+	_hold_ms = millis() + ms;
+	_holding = (0 != ms);
+	}
+
+
+bool Systronix_LCM300::recovery_holding (void)
+	{
+	if (_holding && (0 <= (int32_t)(millis() - _hold_ms)))
+		_holding = false;
+	return _holding;
+	}
+
+
+//---------------------------< R E C O V E R Y _ P R O B E _ D U E >------------------------------------------
+
+bool Systronix_LCM300::recovery_probe_due (void)
+	{
+	return !error.exists && _probe_max_ms && !_probing && (XFER_IDLE == _xfer_state) && !recovery_holding();
+	}
+
+
+//---------------------------< R E C O V E R Y _ P R O B E _ S T A R T >--------------------------------------
+//
+// Read VOUT_MODE from an absent supply, as init() does.  The supply counts as present while the probe is in
+// flight; recovery_result() decides.
+//
+// @return SUCCESS when started, else FAIL
+//
+
+uint8_t Systronix_LCM300::recovery_probe_start (void)
+	{
+	if (!recovery_probe_due())
+		return FAIL;
+
+	error.exists = true;
+	if (SUCCESS != command_start (VOUT_MODE_CMD))
+		{
+		error.exists = false;
+		return FAIL;
+		}
+	_probing = true;
+	recovery.probe_count++;
+	command_poll ();										// puts the command byte on the bus once the interval has elapsed
+	return SUCCESS;
+	}
+
+
+//---------------------------< C O M M A N D _ S T A T U S >--------------------------------------------------
+
+uint8_t Systronix_LCM300::command_status (void)
+	{
+	return _xfer_status;
 	}
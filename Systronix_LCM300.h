@@ -11,6 +11,39 @@
 	@section	HISTORY
 
 
+	v0.33	2026Oct16 stats, schedules and the response ring are caller-owned, attached with stats_attach(), schedule_attach()
+			and response_ring_set(); one built-in response slot
+	v0.32	2026Oct16 LCM300_INSTRUMENTATION 0 empties the timing hooks in the .cpp only; stats stays, so the class layout doesn't depend on it
+	v0.31	2026Oct16 energy_update (meter, frame, ms, pout): gap estimate from the Pout given, not this supply's snapshot
+	v0.30	2026Oct16 milli_shift(): no left shift of a negative value
+	v0.29	2026Oct16 identity_invalidate() forgets learned block read lengths
+	v0.28	2026Oct16 probe() that finds nothing starts the background re-probe backoff
+	v0.27	2026Oct16 stats utilization over a 64-bit elapsed time; no timing calls while stats are disabled
+	v0.26	2026Oct16 command_start_into (cmd_idx, dest) instead of an ambiguous command_start() overload
+	v0.25	2026Oct16 energy_update (meter, frame, ms): captured frames go into a caller's meter, not energy
+	v0.24	2026Oct16 PEC failures tallied in error as LCM300_RD_INVALID
+	v0.23	2026Oct16 short reads and bad block lengths tallied in error as LCM300_RD_INVALID
+	v0.22	2026Oct16 probe(): address-only presence check for discovery
+	v0.21	2026Oct16 bus I/O through a shared Systronix_LCM300_transport instead of a per-instance i2c_t3 copy
+	v0.20	2026Oct16 cmd[] one constexpr table for all instances; typed read<CMD_IDX>()
+	v0.19	2026Oct16 retry, backoff, stuck bus reset, and re-probe of absent supplies for queued commands
+	v0.18	2026Oct16 transaction instrumentation: per-command counts, bytes, latency; histogram; utilization
+	v0.17	2026Oct16 write path: VOUT_COMMAND, OPERATION, WRITE_PROTECT setters with read-back verify
+	v0.16	2026Oct16 adaptive scheduler: schedule_set() per-command periods, priorities and deadlines
+	v0.15	2026Oct16 fault monitor: STATUS_WORD polling, detail reads on change, fault callback and auto clear
+	v0.14	2026Oct16 response_t.us: micros() completion time, for the binary log
+	v0.13	2026Oct16 command_start() responses in a ring or caller-supplied buffer instead of cmd_response
+	v0.12	2026Oct16 eout_average_power() / eout_parse() for captured READ_EOUT frames; no pointer casts
+	v0.11	2026Oct16 energy_update(): 64-bit READ_EOUT energy meter with counter unwrapping; energy_save() / restore()
+	v0.10	2026Oct16 decode_linear11() / decode_linear16() for arrays of raw words
+	v0.9	2026Oct16 linear decode by table lookup instead of powf(); raw_voltage_to_milli(), pmbus_literal_to_milli()
+	v0.8	2026Oct16 optional PMBus packet error checking: pec_set(), table-driven CRC-8
+	v0.7	2026Oct16 block reads of the length the supply returned; length byte checked, errors in pmbus_error
+	v0.6	2026Oct16 identity and limits cache read once by init(); identity_get(), identity_refresh()
+	v0.5	2026Oct16 telemetry snapshot: poll_telemetry() sweep into a timestamped struct; snapshot()
+	v0.4	2026Oct16 command queue: command_queue() / command_dequeue() for Systronix_LCM300_bus
+	v0.3	2026Oct16 non-blocking command_start() / command_poll(); communication interval timed from the
+			last transaction instead of a fixed delay before every transaction
 	v0.2	2018Mar22 bboyes finishing up thanks to some tech support from Artesyn
 	v0.1	2016Dec01 bboyes Start based on LCM300 library
 
@@ -56,6 +89,7 @@ In addition the actual implementation of the LCM300 PMBus interface is not consi
 
 #include <Arduino.h>
 #include <Systronix_i2c_common.h>
+#include <Systronix_LCM300_transport.h>
 
 
 //---------------------------< D E F I N E S >----------------------------------------------------------------
@@ -67,6 +101,24 @@ In addition the actual implementation of the LCM300 PMBus interface is not consi
 #define		LINEAR				2		// 2 byte PMBus literal values (5 bits exponent, 11 bits mantissa) or voltage 16-bit mantissa
 #define		A_BYTE				1		// single byte; not encoded but may be bit mapped (this name because BYTE defined elsewhere)
 #define		A_WORD				2		// two bytes; not encoded but may be bit mapped (this name because similar to A_BYTE
+#define		EOUT				7		// READ_EOUT block: length byte (always 0x06) + 6 payload bytes
+
+enum {LCM300_FMT_BYTE, LCM300_FMT_WORD, LCM300_FMT_LINEAR11, LCM300_FMT_LINEAR16, LCM300_FMT_DIRECT,	// cmd[].format: how
+	LCM300_FMT_ASCII, LCM300_FMT_EOUT};															// a response decodes
+
+template <uint8_t FMT> struct lcm300_type					{typedef float type;};				// read<>() value types:
+template <> struct lcm300_type<LCM300_FMT_BYTE>			{typedef uint8_t type;};			// volts, amps ... for the
+template <> struct lcm300_type<LCM300_FMT_WORD>			{typedef uint16_t type;};			// linear and direct formats,
+template <> struct lcm300_type<LCM300_FMT_ASCII>		{typedef const char* type;};		// the identity string,
+template <> struct lcm300_type<LCM300_FMT_EOUT>			{typedef const uint8_t* type;};		// the READ_EOUT frame
+
+#define		LCM300_CMD_INTERVAL_US	50000	// datasheet communication interval: minimum time between transactions to one supply
+
+#define		LCM300_PENDING		0xFB		// command_poll() return value: transaction still in progress
+#define		LCM300_RD_INVALID	0xF0		// tally_transaction() value for a response that arrived but is no good: short,
+											// bad block length or bad PEC; counted as an error (detail in pmbus_error)
+
+#define		LCM300_RESPONSE_RING	4			// a good size for a response_ring_set() array; see response_find()
 
 
 /** --------  Register Addresses --------
@@ -79,6 +131,12 @@ In addition the actual implementation of the LCM300 PMBus interface is not consi
 // default = 0x80
 #define LCM300_OPERATION_CMD 		0x01					// 8-bit read/write
 
+// values for the OPERATION register, per PMBus; margins act on faults
+#define LCM300_OPERATION_OFF			0x00				// immediate off
+#define LCM300_OPERATION_ON				0x80				// on at VOUT_COMMAND
+#define LCM300_OPERATION_MARGIN_LOW		0x98				// on at VOUT_MARGIN_LOW
+#define LCM300_OPERATION_MARGIN_HIGH	0xA8				// on at VOUT_MARGIN_HIGH
+
 #define	LCM300_CLEAR_FAULTS_CMD		0x03					// write only command; no data
 
 
@@ -112,6 +170,9 @@ In addition the actual implementation of the LCM300 PMBus interface is not consi
 // LCM300 0x3999 = 28.9V
 // LCM300U 0x5666 = 43.2V
 // LCM300W 0x3C0 = 60V
+#define VOUT_MARGIN_HIGH_CMD_VAL	0x25					// 16-bit margin high output voltage, read/write
+#define VOUT_MARGIN_LOW_CMD_VAL		0x26					// 16-bit margin low output voltage, read/write
+
 #define VOUT_MAX_CMD_VAL 			0x24					// 16-bit max output voltage, read-only, returns 0x3999, same as 0xA5
 
 #define FAN_COMMAND_1				0x3B					// 2 byte linear, but only ever returns 0
@@ -153,7 +214,7 @@ In addition the actual implementation of the LCM300 PMBus interface is not consi
 #define	STATUS_TEMP_CMD_VAL			0x7D					// bit mapped status byte
 
 enum {														// these enums are indexes into the cmd array of structs
-	VOUT_MODE_CMD,											// !!! NOTE: additions to the array require same-position additions to the enum !!!
+	VOUT_MODE_CMD,											// each cmd[] entry names its index; cmd_table_ok() fails the build when out of order
 	VOUT_COMMAND_CMD,
 	VOUT_MAX_CMD,
 	READ_EOUT_CMD,
@@ -177,9 +238,118 @@ enum {														// these enums are indexes into the cmd array of structs
 	STATUS_VOUT_CMD,
 	STATUS_IOUT_CMD,
 	STATUS_TEMP_CMD,
+	OPERATION_CMD,
+	WRITE_PROTECT_CMD,
 	CMD_ARRAY_SIZE											// this must be the last member of the enum
 	};
 
+static_assert (CMD_ARRAY_SIZE <= 32, "command queue is a uint32_t bit mask of cmd[] indexes");
+
+#define		CMD_MASK(idx)		((uint32_t)1 << (idx))		// bit for cmd[] index idx in a command queue mask
+
+// commands that poll_telemetry() reads into the telemetry snapshot unless told otherwise by telemetry_set()
+#define		LCM300_TELEMETRY_DEFAULT	(CMD_MASK(READ_VOUT_CMD) | CMD_MASK(READ_IOUT_CMD) | CMD_MASK(READ_POUT_CMD) |	\
+									CMD_MASK(READ_TEMPERATURE_2_CMD) | CMD_MASK(READ_FAN_SPEED_CMD) |			\
+									CMD_MASK(STATUS_WORD_CMD) |			/* the fault monitor reads the rest when they change */	\
+									CMD_MASK(READ_EOUT_CMD))						// keeps the energy meter running
+
+// fault monitor; see fault_capture().  Fault codes are register << 8 | bit number
+#define		LCM300_FAULT_CLEAR_NEVER	0				// fault_monitor_set() clear policies: faults stay latched until clear_faults_cmd()
+#define		LCM300_FAULT_CLEAR_AUTO		1				// CLEAR_FAULTS once the details of a new fault have been read
+
+#define		LCM300_FAULT_REG_WORD		0
+#define		LCM300_FAULT_REG_VOUT		1
+#define		LCM300_FAULT_REG_IOUT		2
+#define		LCM300_FAULT_REG_TEMP		3
+#define		LCM300_FAULT_CODE(reg, bit)	(uint16_t)(((reg) << 8) | (bit))
+
+#define		LCM300_FAULT_VOUT_SUMMARY	0x8020			// STATUS_WORD bits behind STATUS_VOUT: VOUT, VOUT_OV_FAULT
+#define		LCM300_FAULT_IOUT_SUMMARY	0x4010			// STATUS_IOUT: IOUT/POUT, IOUT_OC_FAULT
+#define		LCM300_FAULT_TEMP_SUMMARY	0x0004			// STATUS_TEMP: TEMPERATURE
+
+enum {														// fault codes; fault_name() has the text
+	LCM300_FAULT_NONE_OF_THE_ABOVE = LCM300_FAULT_CODE(LCM300_FAULT_REG_WORD, 0),
+	LCM300_FAULT_CML,
+	LCM300_FAULT_TEMPERATURE,
+	LCM300_FAULT_VIN_UV,
+	LCM300_FAULT_IOUT_OC,
+	LCM300_FAULT_VOUT_OV,
+	LCM300_FAULT_OFF,
+	LCM300_FAULT_BUSY,
+	LCM300_FAULT_UNKNOWN,
+	LCM300_FAULT_OTHER,
+	LCM300_FAULT_FANS,
+	LCM300_FAULT_POWER_GOOD_N,
+	LCM300_FAULT_MFR,
+	LCM300_FAULT_INPUT,
+	LCM300_FAULT_IOUT_POUT,
+	LCM300_FAULT_VOUT,
+
+	LCM300_FAULT_VOUT_TRACKING = LCM300_FAULT_CODE(LCM300_FAULT_REG_VOUT, 0),
+	LCM300_FAULT_VOUT_TOFF_MAX_WARN,
+	LCM300_FAULT_VOUT_TON_MAX_FAULT,
+	LCM300_FAULT_VOUT_MAX_WARN,
+	LCM300_FAULT_VOUT_UV_FAULT,
+	LCM300_FAULT_VOUT_UV_WARN,
+	LCM300_FAULT_VOUT_OV_WARN,
+	LCM300_FAULT_VOUT_OV_FAULT,
+
+	LCM300_FAULT_POUT_OP_WARN = LCM300_FAULT_CODE(LCM300_FAULT_REG_IOUT, 0),
+	LCM300_FAULT_POUT_OP_FAULT,
+	LCM300_FAULT_POWER_LIMIT,
+	LCM300_FAULT_SHARE,
+	LCM300_FAULT_IOUT_UC_FAULT,
+	LCM300_FAULT_IOUT_OC_WARN,
+	LCM300_FAULT_IOUT_OC_LV_FAULT,
+	LCM300_FAULT_IOUT_OC_FAULT,
+
+	LCM300_FAULT_UT_FAULT = LCM300_FAULT_CODE(LCM300_FAULT_REG_TEMP, 4),
+	LCM300_FAULT_UT_WARN,
+	LCM300_FAULT_OT_WARN,
+	LCM300_FAULT_OT_FAULT
+	};
+
+class Systronix_LCM300;
+typedef void (*lcm300_fault_cb_t) (Systronix_LCM300* dev, uint16_t fault, bool asserted);	// fault_monitor_set() event callback
+
+// READ_EOUT energy meter; see energy_update()
+#define		LCM300_EOUT_ACC_MAX			32767			// accumulator rolls over to 0 here, incrementing the rollover count
+#define		LCM300_EOUT_COUNTER_MOD		((uint32_t)256 * LCM300_EOUT_ACC_MAX)	// rollover count * 32767 + accumulator wraps here
+#define		LCM300_EOUT_SAMPLES_MOD		((uint32_t)1 << 24)	// sample count wraps here
+#define		LCM300_EOUT_POWER_MAX		450				// watts; default upper bound on power, for unwrapping; LCM300 is 300W
+#define		LCM300_EOUT_RATE_MAX		10000			// samples/sec; default upper bound on sample rate, for unwrapping
+#define		LCM300_ENERGY_MAGIC			0x454D434C		// 'LCME'; identifies a saved energy_store_t
+
+// static identity and limit commands; init() reads these once into the identity cache
+#define		LCM300_IDENTITY_MASK	(CMD_MASK(VOUT_MODE_CMD) | CMD_MASK(PMBUS_REVISION_CMD) |							\
+									CMD_MASK(MFR_ID_CMD) | CMD_MASK(MFR_MODEL_CMD) | CMD_MASK(MFR_REVISION_CMD) |	\
+									CMD_MASK(MFR_LOCATION_CMD) | CMD_MASK(MFR_DATE_CMD) | CMD_MASK(MFR_SERIAL_CMD) |	\
+									CMD_MASK(MFR_VOUT_MIN_CMD) | CMD_MASK(MFR_VOUT_MAX_CMD) | CMD_MASK(MFR_IOUT_MAX_CMD))
+
+#define		LCM300_TELEMETRY_PERIOD_MS	1000			// default time from the start of one telemetry sweep to the start of the next
+
+// adaptive scheduler; see schedule_attach() and schedule_set()
+#define		LCM300_SCHEDULE_SLOTS		8				// a good size for a schedule_attach() array
+#define		LCM300_SCHEDULE_DEFAULT_SLOTS	7			// schedule_default() needs this many
+#define		LCM300_SCHEDULE_NEAR_LIMIT	0.9f			// fraction of MFR_IOUT_MAX, or of half the MFR_VOUT range from its middle, that is near a limit
+
+// retry and recovery of queued commands; see recovery_set()
+#define		LCM300_RETRIES				2				// default retries of a failed queued command
+#define		LCM300_RETRY_BACKOFF_MS		10				// default hold before the first retry; doubles for each retry after
+#define		LCM300_PROBE_MIN_MS			100				// default re-probe backoff range for an absent supply
+#define		LCM300_PROBE_MAX_MS			5000
+#define		LCM300_OFFLINE_FAILS		5				// failed transactions in a row that make a supply absent
+#define		LCM300_STUCK_TIMEOUTS		3				// timeouts or lost arbitrations in a row that reset the bus
+
+// transaction instrumentation; see stats.  Build the library with -DLCM300_INSTRUMENTATION=0 for no timing calls:
+// the hooks in Systronix_LCM300.cpp are empty and stats stays zero.  stats and the hooks are declared either way,
+// so the class is the same size and layout in every file that includes this one, whatever each of them defines
+#ifndef		LCM300_INSTRUMENTATION
+#define		LCM300_INSTRUMENTATION		1
+#endif
+#define		LCM300_STATS_BINS			12				// latency histogram bins
+#define		LCM300_STATS_BIN0_SHIFT		7				// bin 0 is under 2^7 = 128us; each bin after is twice as wide, the last open ended
+
 
 class Systronix_LCM300
 	{
@@ -187,10 +357,83 @@ class Systronix_LCM300
 		uint8_t		_base;									// base address for this instance; four possible values
 
 		char* 		_wire_name = (char*)"empty";
-		i2c_t3		_wire = Wire;							// why is this assigned value = Wire? [bab]
+		Systronix_LCM300_transport*	_transport = &Systronix_LCM300_i2c_t3::shared (Wire);	// shared by all supplies on the net; see setup()
 
 		uint8_t 	_vout_mode;								// the 3 msb of VOUT_MODE, shifted to 3 lsb of this value
-		int8_t		_linear_exponent;						// the 5 lsb of VOUT_MODE in signed 2's complement
+		int8_t		_linear_exponent = 0;					// the 5 lsb of VOUT_MODE in signed 2's complement
+		float		_vout_scale = 1.0;						// 2^_linear_exponent; set whenever VOUT_MODE is read
+
+		enum {XFER_IDLE, XFER_INTERVAL, XFER_WRITE, XFER_READ};	// command_poll() state machine states
+
+		uint8_t		_xfer_state = XFER_IDLE;				// where the current transaction is
+		uint8_t		_xfer_result = SUCCESS;					// result of the most recently completed transaction
+		int			_xfer_cmd_idx = -1;						// cmd[] index of the transaction in progress
+		bool		_xfer_debug = false;					// print transaction details
+		uint32_t	_interval_us = LCM300_CMD_INTERVAL_US;	// minimum time between transactions to this supply
+		uint32_t	_last_xfer_us = 0;						// micros() when the last transaction to this supply ended
+
+		uint32_t	_queue_mask = 0;						// CMD_MASK() bits of commands waiting to be read
+
+		bool		_pec = false;							// append / verify PMBus packet error check byte
+		uint8_t		_block_count[CMD_ARRAY_SIZE] = {};		// block reads: length byte + 1 from the last good read; 0 = not known
+
+		uint8_t		_xfer_status = I2C_WAITING;				// i2c_t3 status of the most recent failed transaction
+
+		uint8_t		_retries = LCM300_RETRIES;				// recovery policy; see recovery_set()
+		uint32_t	_retry_backoff_ms = LCM300_RETRY_BACKOFF_MS;
+		uint32_t	_probe_min_ms = LCM300_PROBE_MIN_MS;
+		uint32_t	_probe_max_ms = LCM300_PROBE_MAX_MS;
+		uint8_t		_retry[CMD_ARRAY_SIZE] = {};			// retries so far of each failed queued command
+		uint8_t		_fail_streak = 0;						// failed transactions in a row
+		uint8_t		_stuck_streak = 0;						// timeouts and lost arbitrations in a row
+		uint32_t	_probe_ms = LCM300_PROBE_MIN_MS;		// absent: current re-probe backoff
+		bool		_probing = false;						// the transaction in progress is a re-probe
+		bool		_holding = false;						// backing off until _hold_ms
+		uint32_t	_hold_ms = 0;
+		void		recovery_hold (uint32_t ms);
+		void		recovery_offline (void);
+
+		int8_t		_verify_cmd_idx = -1;					// write waiting for write_verify(); -1 when none
+		uint16_t	_verify_raw;							// what was written
+		uint8_t		pmbus_write (uint8_t cmd_byte, uint16_t value, uint8_t count);	// send byte, write byte, write word
+		uint8_t		write_check (int cmd_idx);				// SUCCESS, or FAIL when cached WRITE_PROTECT forbids the write
+		void		output_capture (void);
+		uint8_t		read_count (int cmd_idx);
+		bool		is_block (int cmd_idx);
+		bool		pec_check (uint8_t count);
+		static int32_t	milli_shift (int32_t milli, int8_t exponent);
+
+		uint32_t	_telemetry_mask = LCM300_TELEMETRY_DEFAULT;	// commands that make up a telemetry sweep
+		uint32_t	_telemetry_period_ms = LCM300_TELEMETRY_PERIOD_MS;
+		uint32_t	_telemetry_start_ms;					// millis() at start of the current or last sweep
+		uint32_t	_telemetry_sweep_mask = 0;				// commands of the current sweep not yet complete
+		bool		_telemetry_started = false;				// at least one sweep has been started
+		bool		_telemetry_fresh = false;				// a sweep has completed since poll_telemetry() last said so
+
+		uint32_t	_fault_period_ms = 0;					// STATUS_WORD poll period; 0 = only the reads made anyway
+		uint32_t	_fault_read_ms = 0;						// millis() of the last STATUS_WORD read
+		bool		_fault_started = false;					// STATUS_WORD has been read
+		uint8_t		_fault_policy = LCM300_FAULT_CLEAR_NEVER;
+		bool		_fault_clear_pending = false;			// a new fault is waiting for CLEAR_FAULTS
+		lcm300_fault_cb_t	_fault_cb = NULL;
+
+		void		schedule_capture (bool success);
+		bool		schedule_near_limit (int cmd_idx, float value);
+		void		fault_capture (void);
+		void		fault_detail (uint16_t summary, int cmd_idx, uint8_t reg, uint16_t changed);
+		void		fault_events (uint8_t reg, uint16_t old_bits, uint16_t new_bits);
+
+		void		telemetry_capture (void);
+		void		identity_capture (void);
+		char*		identity_string (int cmd_idx);			// identity field of an ascii command
+
+		float		_energy_power_max = LCM300_EOUT_POWER_MAX;
+		float		_energy_rate_max = LCM300_EOUT_RATE_MAX;
+		int8_t		telemetry_field (int cmd_idx);
+
+		uint8_t		xfer_end (uint8_t result);
+		uint8_t		response_get (void);
+		void		interval_wait (void);
 
 	public:
 		error_t		error;									// error struct typdefed in Systronix_i2c_common.h
@@ -218,44 +461,63 @@ class Systronix_LCM300
 			} data;
 */
 
-		struct lcm300_cmd_struct
+		struct cmd_t
 			{
+			uint8_t		idx;								// its own cmd[] index; checked at compile time
 			uint8_t		cmd_byte;							// from the defines above
-			size_t		count;								// number of bytes the command reads
-			} cmd[CMD_ARRAY_SIZE]=							// !!! NOTE: additions here require same-position additions to the enum !!!
-				{
-				{VOUT_MODE_CMD_VAL,				A_BYTE},
-				{VOUT_COMMAND_CMD_VAL,			LINEAR},
-				{VOUT_MAX_CMD_VAL,				LINEAR},
-				{READ_EOUT_CMD_VAL,				7},			// Average power since the last reading; 6 bytes plus 1 byte payload-length byte (0x06 always)
-				{READ_VOUT_CMD_VAL,				LINEAR},
-				{READ_IOUT_CMD_VAL,				LINEAR},
-				{READ_TEMPERATURE_2_CMD_VAL,	LINEAR},
-				{READ_FAN_SPEED_CMD_VAL,		LINEAR},
-				{READ_POUT_CMD_VAL,				LINEAR},	// power, but this is PMBus literal
-				{MFR_ID_CMD_VAL,				ASCII},		// length byte + 16 payload bytes - even if we don't need that many,
-				{MFR_MODEL_CMD_VAL,				ASCII},		// easier to just read 17 than to do separate operations
-				{MFR_REVISION_CMD_VAL,			ASCII},		// that figure out exactly how many bytes to read
-				{MFR_LOCATION_CMD_VAL,			ASCII},
-				{MFR_DATE_CMD_VAL,				ASCII},		// pointless; returns string 'YYMMDD'
-				{MFR_SERIAL_CMD_VAL,			ASCII},		// pointless; returns string '123456789ABCD'
-				{PMBUS_REVISION_CMD_VAL,		A_BYTE},
-				{MFR_VOUT_MIN_CMD_VAL,			LINEAR},
-				{MFR_VOUT_MAX_CMD_VAL,			LINEAR},
-				{MFR_IOUT_MAX_CMD_VAL,			LINEAR},
-				{STATUS_BYTE_CMD_VAL,			A_BYTE},
-				{STATUS_WORD_CMD_VAL,			A_WORD},
-				{STATUS_VOUT_CMD_VAL,			A_BYTE},
-				{STATUS_IOUT_CMD_VAL,			A_BYTE},
-				{STATUS_TEMP_CMD_VAL,			A_BYTE}
-				};
-
-		union												// command responses are written here
+			uint8_t		count;								// number of bytes the command reads
+			uint8_t		format;								// LCM300_FMT_...
+			};
+
+		static constexpr cmd_t cmd[CMD_ARRAY_SIZE] =		// one copy in flash for all instances; order must match the enum
+			{
+			{VOUT_MODE_CMD,				VOUT_MODE_CMD_VAL,				A_BYTE,	LCM300_FMT_BYTE},
+			{VOUT_COMMAND_CMD,			VOUT_COMMAND_CMD_VAL,			LINEAR,	LCM300_FMT_LINEAR16},
+			{VOUT_MAX_CMD,				VOUT_MAX_CMD_VAL,				LINEAR,	LCM300_FMT_LINEAR16},
+			{READ_EOUT_CMD,				READ_EOUT_CMD_VAL,				EOUT,	LCM300_FMT_EOUT},	// Average power since the last reading; 6 bytes plus 1 byte payload-length byte (0x06 always)
+			{READ_VOUT_CMD,				READ_VOUT_CMD_VAL,				LINEAR,	LCM300_FMT_LINEAR16},
+			{READ_IOUT_CMD,				READ_IOUT_CMD_VAL,				LINEAR,	LCM300_FMT_LINEAR11},
+			{READ_TEMPERATURE_2_CMD,	READ_TEMPERATURE_2_CMD_VAL,		LINEAR,	LCM300_FMT_LINEAR11},
+			{READ_FAN_SPEED_CMD,		READ_FAN_SPEED_CMD_VAL,			LINEAR,	LCM300_FMT_DIRECT},	// rpm, not divided by exponent
+			{READ_POUT_CMD,				READ_POUT_CMD_VAL,				LINEAR,	LCM300_FMT_LINEAR11},	// power, but this is PMBus literal
+			{MFR_ID_CMD,				MFR_ID_CMD_VAL,					ASCII,	LCM300_FMT_ASCII},	// length byte + 16 payload bytes - even if we don't need that many,
+			{MFR_MODEL_CMD,				MFR_MODEL_CMD_VAL,				ASCII,	LCM300_FMT_ASCII},	// easier to just read 17 than to do separate operations
+			{MFR_REVISION_CMD,			MFR_REVISION_CMD_VAL,			ASCII,	LCM300_FMT_ASCII},	// that figure out exactly how many bytes to read
+			{MFR_LOCATION_CMD,			MFR_LOCATION_CMD_VAL,			ASCII,	LCM300_FMT_ASCII},
+			{MFR_DATE_CMD,				MFR_DATE_CMD_VAL,				ASCII,	LCM300_FMT_ASCII},	// pointless; returns string 'YYMMDD'
+			{MFR_SERIAL_CMD,			MFR_SERIAL_CMD_VAL,				ASCII,	LCM300_FMT_ASCII},	// pointless; returns string '123456789ABCD'
+			{PMBUS_REVISION_CMD,		PMBUS_REVISION_CMD_VAL,			A_BYTE,	LCM300_FMT_BYTE},
+			{MFR_VOUT_MIN_CMD,			MFR_VOUT_MIN_CMD_VAL,			LINEAR,	LCM300_FMT_LINEAR16},
+			{MFR_VOUT_MAX_CMD,			MFR_VOUT_MAX_CMD_VAL,			LINEAR,	LCM300_FMT_LINEAR16},
+			{MFR_IOUT_MAX_CMD,			MFR_IOUT_MAX_CMD_VAL,			LINEAR,	LCM300_FMT_LINEAR11},
+			{STATUS_BYTE_CMD,			STATUS_BYTE_CMD_VAL,			A_BYTE,	LCM300_FMT_BYTE},
+			{STATUS_WORD_CMD,			STATUS_WORD_CMD_VAL,			A_WORD,	LCM300_FMT_WORD},
+			{STATUS_VOUT_CMD,			STATUS_VOUT_CMD_VAL,			A_BYTE,	LCM300_FMT_BYTE},
+			{STATUS_IOUT_CMD,			STATUS_IOUT_CMD_VAL,			A_BYTE,	LCM300_FMT_BYTE},
+			{STATUS_TEMP_CMD,			STATUS_TEMP_CMD_VAL,			A_BYTE,	LCM300_FMT_BYTE},
+			{OPERATION_CMD,				LCM300_OPERATION_CMD,			A_BYTE,	LCM300_FMT_BYTE},
+			{WRITE_PROTECT_CMD,			LCM300_WRITE_PROTECT_CMD,		A_BYTE,	LCM300_FMT_BYTE}
+			};
+
+		static constexpr bool	cmd_table_ok (int i=0)		// every cmd[] entry at its own index
+			{return (CMD_ARRAY_SIZE == i) || ((cmd[i].idx == i) && cmd_table_ok (i + 1));}
+
+		union cmd_response_t								// command responses are written here
 			{
 			char		as_array[ASCII+1];					// length byte + max sixteen payload bytes + NULL terminator (always write here but fetch from any one of the three)
 			uint16_t	as_word;
 			uint8_t		as_byte;
-			} cmd_response;
+			} cmd_response;									// command_read() responses
+
+		struct response_t									// command_start() responses; one per read, so reads don't clobber each other
+			{
+			cmd_response_t	data;							// the response, as in cmd_response
+			int			cmd_idx;							// cmd[] index of the command read
+			uint8_t		result;								// LCM300_PENDING while in flight, then SUCCESS or FAIL
+			uint32_t	ms;									// millis() when the read completed
+			uint32_t	us;									// micros() when the read completed
+			uint32_t	seq;								// ring sequence number; 0 for caller-supplied buffers
+			};
 
 		struct												// all of the data necessary for and the results of the READ_EOUT command calculations
 			{
@@ -263,20 +525,187 @@ class Systronix_LCM300
 			uint16_t	accumulator;						// accumulated energy per sample (rolls over at 32767? supposed to be 'PMBus linear' but this value seems to be direct)
 			uint8_t		rollover_count;						// number of times that accumulator has overflowed
 			uint16_t	last_rollover_count;
-			uint32_t	sample_count;						// 24 bits; upper 8 must be discarded or treated as PEC (Packet Error Check is a crc-8 not supported in this code)
+			uint32_t	sample_count;						// 24 bits; upper 8 must be discarded; they are the PEC byte when pec_set(true)
 			uint32_t	last_sample_count;					// the previous one
 			uint32_t	energy_count;						// intermediate calculation result
 			uint32_t	last_energy_count;					// from the last time
 			uint32_t	average_power;						// final result
 			} eout_data;
 
-		uint8_t		setup (uint8_t base, i2c_t3 wire, char* name);	// constructor
+		struct energy_t										// lifetime READ_EOUT energy meter; see energy_update()
+			{
+			uint64_t	energy_mws;							// output energy, milliwatt-seconds, from unambiguous intervals
+			uint64_t	energy_raw;							// same in READ_EOUT units (watt-samples)
+			uint64_t	samples;							// READ_EOUT samples in unambiguous intervals
+			uint64_t	gap_estimate_mws;					// estimate for ambiguous intervals from Pout; not in energy_mws
+			uint32_t	gap_ms;								// time in ambiguous intervals
+			uint32_t	intervals;							// unambiguous intervals accounted
+			uint32_t	ambiguous_count;					// intervals that couldn't be unwrapped with certainty
+			float		sample_rate;						// samples per second, learned; 0 until known
+			float		average_power;						// watts, over the last unambiguous interval
+			uint32_t	last_counter;						// rollover count * 32767 + accumulator at last read
+			uint32_t	last_samples;						// sample count at last read
+			uint32_t	last_ms;							// millis() at last read
+			bool		baseline;							// last_* are valid
+			} energy = {};
+
+		struct energy_store_t								// energy_save() / energy_restore() image, e.g. for EEPROM
+			{
+			uint32_t	magic;								// LCM300_ENERGY_MAGIC
+			uint64_t	energy_mws;
+			uint64_t	energy_raw;
+			uint64_t	samples;
+			uint64_t	gap_estimate_mws;
+			uint32_t	gap_ms;
+			uint32_t	intervals;
+			uint32_t	ambiguous_count;
+			float		sample_rate;
+			uint8_t		crc;								// pec_crc8() of everything above
+			};
+
+		struct												// errors the i2c layer can't see; not included in error
+			{
+			uint32_t	short_read_count;					// fewer bytes received than requested
+			uint32_t	block_length_count;					// block read length byte too big for the command or bigger than the bytes received
+			uint32_t	pec_count;							// packet error check byte didn't match the received data
+			} pmbus_error = {};
+
+		struct												// retry and recovery; see recovery_set()
+			{
+			uint32_t	retry_count;						// failed queued commands queued again
+			uint32_t	giveup_count;						// failed queued commands out of retries
+			uint32_t	bus_reset_count;					// stuck bus resets
+			uint32_t	offline_count;						// times the supply was made absent
+			uint32_t	probe_count;						// re-probes while absent
+			uint32_t	online_count;						// re-probes that found it
+			uint32_t	offline_ms;							// millis() when it was last made absent
+			uint32_t	outage_ms;							// length of the most recent absence
+			} recovery = {};
+
+		struct stats_cmd_t									// one command's transactions; see stats
+			{
+			uint32_t	count;								// successful or not
+			uint32_t	fail_count;
+			uint32_t	bytes;								// on the bus: command, data, and PEC bytes; not address bytes
+			uint32_t	latency_min_us;						// from start of the command byte to end of the response
+			uint32_t	latency_max_us;
+			uint64_t	latency_sum_us;						// average is latency_sum_us / count
+			};
+
+		struct stats_t										// where this supply's bus time goes; see stats_attach()
+			{
+			stats_cmd_t	cmd[CMD_ARRAY_SIZE];				// reads, by cmd[] index
+			stats_cmd_t	write;								// all writes, CLEAR_FAULTS included
+			uint32_t	histogram[LCM300_STATS_BINS];		// latency of every transaction; see LCM300_STATS_BIN0_SHIFT
+			uint64_t	busy_us;							// sum of all latencies
+			uint64_t	wait_us;							// command_start() or blocking write to start of the command byte: interval, queueing
+			uint32_t	nak_count;							// address or data NAK
+			uint32_t	timeout_count;
+			uint32_t	short_read_count;					// fewer bytes received than requested
+			uint64_t	elapsed_us;							// since stats_reset(); advanced by every transaction and stats_utilization()
+			uint32_t	clock_us;							// micros() elapsed_us was last advanced to
+			};
+
+		enum {TELEM_VOUT, TELEM_IOUT, TELEM_POUT, TELEM_TEMP_2, TELEM_FAN_SPEED, TELEM_STATUS_BYTE,
+			TELEM_STATUS_WORD, TELEM_STATUS_VOUT, TELEM_STATUS_IOUT, TELEM_STATUS_TEMP, TELEM_FIELDS};	// telemetry.read_ms[] indexes
+
+		struct telemetry_t									// decoded results of the most recent successful read of each command
+			{
+			float		vout;								// volts
+			float		iout;								// amps
+			float		pout;								// watts
+			float		temperature_2;						// degrees C
+			uint16_t	fan_speed;							// rpm; direct, see READ_FAN_SPEED_CMD_VAL
+			uint16_t	status_word;
+			uint8_t		status_byte;
+			uint8_t		status_vout;
+			uint8_t		status_iout;
+			uint8_t		status_temp;
+			uint32_t	valid;								// CMD_MASK() bits of fields that hold a successful read
+			uint32_t	read_ms[TELEM_FIELDS];				// millis() of each field's most recent successful read
+			uint32_t	sweep_ms;							// millis() when the most recent sweep completed
+			uint32_t	sweep_count;						// number of completed sweeps
+			} telemetry = {};
+
+		struct fault_t										// fault monitor state; see fault_monitor_set()
+			{
+			uint16_t	status_word;						// most recent STATUS_WORD
+			uint8_t		status_vout;						// details, read when the summary bits in STATUS_WORD change;
+			uint8_t		status_iout;						// 0 while the summary bits are clear
+			uint8_t		status_temp;
+			uint32_t	change_ms;							// millis() of the most recent event
+			uint32_t	event_count;						// events, asserted and deasserted
+			uint32_t	drill_count;						// detail reads queued
+			uint32_t	clear_count;						// CLEAR_FAULTS sent by the auto clear policy
+			} faults = {};
+
+		struct schedule_t									// one command's adaptive schedule and its stats; see schedule_attach()
+			{
+			int8_t		cmd_idx;
+			uint8_t		priority;							// higher is read first when several commands are queued
+			uint32_t	period_min_ms;						// period range; equal for a fixed period.  period_max_ms 0: slot is free
+			uint32_t	period_max_ms;
+			uint32_t	period_ms;							// current period
+			uint32_t	deadline_ms;						// a read later than this after it fell due is a miss
+			float		tolerance;							// change between reads, in volts, amps ..., that speeds up polling
+			float		last_value;
+			uint32_t	due_ms;								// millis() when the next read falls due
+			bool		queued;								// waiting to be read
+
+			uint32_t	read_count;							// stats: successful reads, any source
+			uint32_t	fail_count;
+			uint32_t	miss_count;							// scheduled reads that missed their deadline
+			uint32_t	late_max_ms;						// worst and total time from due to read, scheduled reads
+			uint32_t	late_sum_ms;
+			uint32_t	speedup_count;						// period halved: changing fast or near a limit
+			uint32_t	backoff_count;						// period lengthened: stable
+			};
+
+		struct identity_t									// static identity and limits; read once by init(), see LCM300_IDENTITY_MASK
+			{
+			char		mfr_id[ASCII];						// null-terminated; 16 chars max + NULL
+			char		mfr_model[ASCII];
+			char		mfr_revision[ASCII];
+			char		mfr_location[ASCII];
+			char		mfr_date[ASCII];
+			char		mfr_serial[ASCII];
+			uint8_t		pmbus_revision;
+			uint8_t		vout_mode;							// raw VOUT_MODE byte
+			float		mfr_vout_min;						// volts
+			float		mfr_vout_max;						// volts
+			float		mfr_iout_max;						// amps
+			uint32_t	valid;								// CMD_MASK() bits of fields that hold a successful read
+			} identity = {};
+
+		struct output_t										// write path; see vout_set()
+			{
+			float		vout_command;						// volts; VOUT_COMMAND as last read back
+			float		vout_max;							// volts; VOUT_MAX
+			uint8_t		operation;							// OPERATION as last read back
+			uint8_t		write_protect;						// WRITE_PROTECT as last read back
+			uint32_t	valid;								// CMD_MASK() bits of fields that hold a successful read
+
+			uint32_t	write_count;						// writes sent
+			uint32_t	verify_fail_count;					// read back different from what was written
+			uint32_t	clamp_count;						// vout_set() volts outside the limits
+			uint32_t	protect_count;						// writes not sent because WRITE_PROTECT forbids them
+			} output = {};
+
+		uint8_t		setup (uint8_t base, Systronix_LCM300_transport& transport, char* name);	// constructor
+		uint8_t		setup (uint8_t base, i2c_t3& wire, char* name);	// with Systronix_LCM300_i2c_t3::shared (wire)
+		Systronix_LCM300_transport&	transport_get (void) {return *_transport;}
 
 		void		begin (i2c_pins pins);
 		void		begin (void)							// default begin() (Wire0)
 						{begin (I2C_PINS_18_19);}
 
-		uint8_t		init (void);							// device present and communicating detector
+		uint8_t		init (bool read_identity=true);			// device present and communicating detector; fills identity cache
+		uint8_t		probe (void);							// address only: SUCCESS when acknowledged, else ABSENT; sets error.exists
+
+		const identity_t&	identity_get (void);			// the identity struct; no bus traffic
+		bool		identity_valid (void);					// true when every LCM300_IDENTITY_MASK field has been read
+		void		identity_invalidate (void);				// forget cached identity and block lengths; e.g. supply swapped
+		void		identity_refresh (void);				// queue reads of the identity fields that aren't valid
 
 		void		reset_bus (void);
 		uint32_t	reset_bus_count_read (void);
@@ -284,16 +713,144 @@ class Systronix_LCM300
 		uint8_t		base_get (void);
 
 		uint8_t		clear_faults_cmd (void);
+
+		uint8_t		vout_set (float volts, bool verify=true);	// VOUT_COMMAND, clamped to MFR_VOUT_MIN - min(MFR_VOUT_MAX, VOUT_MAX)
+		uint8_t		operation_set (uint8_t operation, bool verify=true);	// LCM300_OPERATION_...
+		uint8_t		output_set (bool on, bool verify=true);
+		uint8_t		margin_set (int8_t direction, bool verify=true);	// < 0 low, 0 nominal, > 0 high
+		uint8_t		write_protect_set (uint8_t write_protect, bool verify=true);	// LCM300_WP_...
+		uint8_t		write_verify (void);					// read back the last unverified write; SUCCESS, FAIL, or ABSENT
 		uint8_t 	command_read (int cmd_idx, bool debug=false);	// read raw data from lcm300 in response to command indexed by cmd_idx
 
+		template <int CMD_IDX>								// blocking read, decoded: float volts, amps ...; uint8_t / uint16_t
+		uint8_t		read (typename lcm300_type<cmd[CMD_IDX].format>::type& value)	// status; identity string; EOUT frame
+			{
+			static_assert ((0 <= CMD_IDX) && (CMD_IDX < CMD_ARRAY_SIZE), "read<>() takes a cmd[] index such as READ_VOUT_CMD");
+			uint8_t	ret_val = command_read (CMD_IDX);
+
+			if (SUCCESS == ret_val)
+				decode_response (CMD_IDX, value);
+			return ret_val;
+			}
+
+		void		decode_response (int cmd_idx, float& value);	// cmd_response as cmd[cmd_idx].format
+		void		decode_response (int cmd_idx, uint8_t& value);
+		void		decode_response (int cmd_idx, uint16_t& value);
+		void		decode_response (int cmd_idx, const char*& value);
+		void		decode_response (int cmd_idx, const uint8_t*& value);
+		float		decode (int cmd_idx, uint16_t raw);		// a byte or word response to volts, amps ...; status as is
+
+		uint8_t		command_start (int cmd_idx, bool debug=false);	// non-blocking version of command_read(); complete with command_poll()
+		uint8_t		command_start_into (int cmd_idx, response_t* dest, bool debug=false);	// same; response into dest
+		uint8_t		response_ring_set (response_t* ring, uint8_t count);	// command_start() responses go round ring[count]; NULL: built-in slot
+		const response_t*	response_last (void);			// most recent command_start() response; NULL before the first
+		const response_t*	response_find (uint32_t seq);	// ring response seq; NULL once overwritten or while in flight
+		uint32_t	response_seq (void);					// sequence number of the most recent ring response
+		uint8_t		command_poll (void);					// advance the transaction; LCM300_PENDING until it is complete
+		bool		command_busy (void);					// true while a transaction is in progress
+		int			command_idx_get (void);					// cmd[] index of the current or most recent transaction
+		uint8_t		command_status (void);					// i2c_t3 status of the most recent failed transaction
+
+		void		recovery_set (uint8_t retries, uint32_t retry_backoff_ms=LCM300_RETRY_BACKOFF_MS,
+						uint32_t probe_min_ms=LCM300_PROBE_MIN_MS, uint32_t probe_max_ms=LCM300_PROBE_MAX_MS);	// probe_max_ms 0: no re-probe
+		uint8_t		recovery_result (uint8_t result);		// queue drivers: each completed command; LCM300_PENDING when nothing to report
+		bool		recovery_holding (void);				// backing off; start nothing
+		bool		recovery_probe_due (void);				// absent and time for a re-probe
+		uint8_t		recovery_probe_start (void);			// start the re-probe; finish like any command_start()
+
+		void		stats_attach (stats_t* stats);			// count into *stats from now, zeroed; NULL stops counting
+		const stats_t*	stats_get (void);					// NULL when none attached
+		void		stats_reset (void);						// zero stats and start timing utilization from now
+		void		stats_enable (bool enable);				// stop / resume counting; default on
+		float		stats_utilization (void);				// fraction of the time since stats_reset() this supply had the bus
+
+		void		command_queue (int cmd_idx);			// add a command to the queue of commands waiting to be read
+		void		command_queue_mask (uint32_t mask);		// add several: mask is CMD_MASK(idx) | CMD_MASK(idx) ...
+		uint32_t	command_queued (void);					// mask of queued commands
+		int			command_dequeue (void);					// remove and return lowest queued cmd[] index; -1 when empty
+		void		command_queue_clear (void);
+		uint8_t		command_service (void);					// without Systronix_LCM300_bus: read queued commands, one per call
+
+		void		telemetry_set (uint32_t mask, uint32_t period_ms);	// what poll_telemetry() reads and how often
+		uint8_t		telemetry_schedule (void);				// queue a sweep if one is due; SUCCESS when queued
+		uint8_t		poll_telemetry (void);					// call from loop(); SUCCESS once each time a sweep completes
+		const telemetry_t&	snapshot (void);				// the telemetry struct; no bus traffic
+		uint32_t	telemetry_age (int cmd_idx);			// ms since telemetry field for cmd_idx was read; UINT32_MAX if never
+
+		uint8_t		schedule_attach (schedule_t* slots, uint8_t count);	// schedules kept in slots[count], cleared; NULL: none
+		uint8_t		schedule_set (int cmd_idx, uint32_t period_min_ms, uint32_t period_max_ms, uint8_t priority=0,
+						float tolerance=0, uint32_t deadline_ms=0);	// period_max_ms 0 removes; SUCCESS or FAIL
+		uint8_t		schedule_default (void);				// adaptive schedules for the telemetry commands, in place of the sweep
+		void		schedule_clear (void);
+		uint8_t		schedule_queue (void);					// queue the commands that are due; called by telemetry_schedule()
+		const schedule_t*	schedule_get (int cmd_idx);		// NULL when cmd_idx has no schedule
+
+		void		fault_monitor_set (uint32_t period_ms, uint8_t clear_policy=LCM300_FAULT_CLEAR_NEVER, lcm300_fault_cb_t fault_cb=NULL);
+		uint8_t		fault_schedule (void);					// queue STATUS_WORD when due; called by telemetry_schedule()
+		bool		fault_active (uint16_t fault);			// is this LCM300_FAULT_... set
+		static const char*	fault_name (uint16_t fault);
+		bool		fault_clear_pending (void);
+		uint8_t		fault_clear_service (void);				// send a pending auto CLEAR_FAULTS when the supply is free
+
+		void		pec_set (bool enable);					// PMBus packet error checking on (true) or off (default)
+		bool		pec_get (void);
+		static uint8_t	pec_crc8 (uint8_t crc, const uint8_t* data, size_t count);	// PMBus PEC: CRC-8, x^8 + x^2 + x + 1
+
+		void		interval_set (uint32_t interval_us);	// override the default LCM300_CMD_INTERVAL_US
+		uint32_t	interval_remaining (void);				// microseconds until this supply may be addressed again
+
 		float		raw_voltage_to_float (uint16_t volt_raw);
 		float		pmbus_literal_to_float (uint16_t literal_raw);
-		void		pmbus_average_power (void);
+		int32_t		raw_voltage_to_milli (uint16_t volt_raw);			// millivolts; no floating point
+		int32_t		pmbus_literal_to_milli (uint16_t literal_raw);		// milliamps, milliwatts, etc; no floating point
+
+		static void	decode_linear11 (const uint16_t* raw, float* value, size_t count);	// arrays; see Systronix_LCM300_batch.cpp
+		static void	decode_linear16 (const uint16_t* raw, float* value, size_t count, int8_t exponent);
+		void		pmbus_average_power (void);				// eout_data from the READ_EOUT response in cmd_response
+		uint8_t		eout_average_power (const uint8_t* frame);	// eout_data from a captured 7-byte READ_EOUT frame
+		static uint8_t	eout_parse (const uint8_t* frame, uint32_t* energy_count, uint32_t* sample_count);
+		static size_t	eout_power_bulk (const uint8_t* frames, size_t count, float* watts);	// see Systronix_LCM300_batch.cpp
+
+		uint8_t		energy_update (void);					// account the READ_EOUT response in cmd_response; automatic on every READ_EOUT read
+		uint8_t		energy_update (energy_t& meter, const uint8_t* frame, uint32_t ms, float pout);	// a captured frame read at ms, Pout then (< 0 unknown), into a meter of your own
+		void		energy_limits_set (float power_max, float rate_max);	// bounds used to unwrap READ_EOUT counters
+		void		energy_save (energy_store_t* store);
+		uint8_t		energy_restore (const energy_store_t* store);
+		static uint8_t	energy_crc (const energy_store_t* store);
+
+	protected:												// after the public types they use
+		cmd_response_t*	_xfer_data = &cmd_response;			// where the transaction in progress puts its response
+		response_t*	_xfer_response = NULL;					// and its response_t, when it has one
+		response_t*	_last_response = NULL;					// most recently completed command_start() response
+		response_t	_response = {};							// command_start() response when no ring is set
+		response_t*	_ring = NULL;							// response_ring_set(); command_start() responses without a caller-supplied buffer
+		uint8_t		_ring_size = 0;
+		uint32_t	_ring_seq = 0;							// sequence number of the most recent ring response
+		response_t*	response_slot (uint32_t seq);
+
+		schedule_t*	_schedule = NULL;						// schedule_attach()
+		uint8_t		_schedule_count = 0;
+		stats_t*	_stats = NULL;							// stats_attach()
+
+		uint8_t		xfer_start (int cmd_idx, response_t* dest, bool debug);	// begin a read; NULL dest is cmd_response
+
+		bool		_stats_enabled = true;
+		uint32_t	_stats_start_us;						// command_start()
+		uint32_t	_stats_bus_us;							// command byte went out
+		uint8_t		_stats_bytes;							// bytes of the read in progress when it succeeds
+
+		void		stats_start (void);						// timing hooks; empty when the library is built with LCM300_INSTRUMENTATION 0
+		void		stats_bus (void);
+		void		stats_end (uint8_t result);
+		void		stats_write (uint8_t bytes, uint8_t result);
+		void		stats_record (stats_cmd_t& entry, uint8_t bytes, uint8_t result);
 
 		private:
 
 	};
 
+static_assert (Systronix_LCM300::cmd_table_ok(), "cmd[] entries must be in cmd[] index enum order");
+
 extern Systronix_LCM300 lcm300;
 
 #endif /* SYSTRONIX_LCM300_h */
@@ -0,0 +1,169 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_batch.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; batch decoding of arrays of raw PMBus linear words
+	v0.2	2026Oct16 eout_power_bulk()
+
+*/
+/******************************************************************************/
+
+/** --------  Description --------------------------------------------------------------------------
+
+Decode arrays of raw linear-11 (PMBus literal) and linear-16 (VOUT_MODE) words, typically downloaded
+from a data logger and post-processed on a PC. Same results, bit for bit, as pmbus_literal_to_float()
+and raw_voltage_to_float().
+
+Instead of looking 2^exponent up in a table, the float is built directly: a float with exponent field
+(e + 127) and zero fraction is exactly 2^e for the -16..15 range of PMBus exponents. That needs only
+integer shifts and adds, so compilers can vectorize the plain loops. On x86 with SSE2 there is also an
+explicit SIMD version that does eight words per iteration.
+
+Also average power for a run of captured READ_EOUT frames.
+
+--------------------------------------------------------------------------------------------------*/
+
+#include <Systronix_LCM300.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+//---------------------------< E X P 2 _ B I T S >------------------------------------------------------------
+//
+// 2^exponent as a float, built from its bits
+//
+
+static inline float exp2_bits (int32_t exponent)
+	{
+	uint32_t	bits = (uint32_t)(exponent + 127) << 23;
+	float		result;
+
+	memcpy (&result, &bits, sizeof(result));				// compilers turn this into a register move
+	return result;
+	}
+
+
+//---------------------------< D E C O D E _ L I N E A R 1 1 >------------------------------------------------
+/*!
+	@brief	Decode count PMBus linear-11 words (READ_IOUT, READ_POUT, READ_TEMPERATURE_2, ...) from raw[] into
+			value[].  Same results as pmbus_literal_to_float().  raw[] and value[] must not overlap.
+*/
+
+void Systronix_LCM300::decode_linear11 (const uint16_t* raw, float* value, size_t count)
+	{
+	size_t	i = 0;
+
+#if defined(__SSE2__)
+	const __m128i	bias = _mm_set1_epi32 (127);
+
+	for (; i + 8 <= count; i += 8)
+		{
+		__m128i	word = _mm_loadu_si128 ((const __m128i*)&raw[i]);
+		__m128i	exponent = _mm_srai_epi16 (word, 11);							// sign extended 5-bit exponent
+		__m128i	mantissa = _mm_srai_epi16 (_mm_slli_epi16 (word, 5), 5);		// sign extended 11-bit mantissa
+
+		__m128i	exponent_lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (exponent, exponent), 16);	// widen to 32 bits
+		__m128i	exponent_hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (exponent, exponent), 16);
+		__m128i	mantissa_lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (mantissa, mantissa), 16);
+		__m128i	mantissa_hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (mantissa, mantissa), 16);
+
+		__m128	scale_lo = _mm_castsi128_ps (_mm_slli_epi32 (_mm_add_epi32 (exponent_lo, bias), 23));
+		__m128	scale_hi = _mm_castsi128_ps (_mm_slli_epi32 (_mm_add_epi32 (exponent_hi, bias), 23));
+
+		_mm_storeu_ps (&value[i], _mm_mul_ps (_mm_cvtepi32_ps (mantissa_lo), scale_lo));
+		_mm_storeu_ps (&value[i + 4], _mm_mul_ps (_mm_cvtepi32_ps (mantissa_hi), scale_hi));
+		}
+#endif
+
+	for (; i < count; i++)
+		{
+		int32_t	exponent = (int16_t)raw[i] >> 11;
+		int32_t	mantissa = (int16_t)(raw[i] << 5) >> 5;
+
+		value[i] = (float)mantissa * exp2_bits (exponent);
+		}
+	}
+
+
+//---------------------------< D E C O D E _ L I N E A R 1 6 >------------------------------------------------
+/*!
+	@brief	Decode count VOUT_MODE linear words (READ_VOUT, VOUT_COMMAND, MFR_VOUT_MIN, ...) from raw[] into
+			value[] using exponent, the sign-extended 5 lsbs of VOUT_MODE.  Same results as
+			raw_voltage_to_float() on an instance whose VOUT_MODE exponent is exponent.  raw[] and value[]
+			must not overlap.
+*/
+
+void Systronix_LCM300::decode_linear16 (const uint16_t* raw, float* value, size_t count, int8_t exponent)
+	{
+	const float	scale = exp2_bits (exponent);
+	size_t		i = 0;
+
+#if defined(__SSE2__)
+	const __m128	scale4 = _mm_set1_ps (scale);
+	const __m128i	zero = _mm_setzero_si128 ();
+
+	for (; i + 8 <= count; i += 8)
+		{
+		__m128i	word = _mm_loadu_si128 ((const __m128i*)&raw[i]);
+
+		_mm_storeu_ps (&value[i], _mm_mul_ps (_mm_cvtepi32_ps (_mm_unpacklo_epi16 (word, zero)), scale4));	// zero extend
+		_mm_storeu_ps (&value[i + 4], _mm_mul_ps (_mm_cvtepi32_ps (_mm_unpackhi_epi16 (word, zero)), scale4));
+		}
+#endif
+
+	for (; i < count; i++)
+		value[i] = (float)raw[i] * scale;
+	}
+
+
+//---------------------------< E O U T _ P O W E R _ B U L K >------------------------------------------------
+//
+// Average power between successive READ_EOUT frames from one supply, in the order read: count frames of EOUT
+// bytes each, packed, give count-1 results; watts[i] is the power between frames[i] and frames[i+1].  Same math
+// as eout_average_power() but fractional watts.  Where a frame is not a READ_EOUT frame, or no samples were
+// taken, the result is NAN.
+//
+// @return number of results written
+//
+
+size_t Systronix_LCM300::eout_power_bulk (const uint8_t* frames, size_t count, float* watts)
+	{
+	uint32_t	energy_count;
+	uint32_t	sample_count;
+	uint32_t	last_energy_count = 0;
+	uint32_t	last_sample_count = 0;
+	uint32_t	sample_delta;
+	bool		last_valid;
+	size_t		i;
+
+	if (2 > count)
+		return 0;
+
+	last_valid = (SUCCESS == eout_parse (frames, &last_energy_count, &last_sample_count));
+	for (i=1; i<count; i++)
+		{
+		if (SUCCESS != eout_parse (frames + i * EOUT, &energy_count, &sample_count))
+			{
+			watts[i-1] = NAN;
+			last_valid = false;
+			continue;
+			}
+
+		sample_delta = (sample_count - last_sample_count) & (LCM300_EOUT_SAMPLES_MOD - 1);
+		if (last_valid && sample_delta)
+			watts[i-1] = (float)((energy_count + LCM300_EOUT_COUNTER_MOD - last_energy_count) % LCM300_EOUT_COUNTER_MOD) / sample_delta;
+		else
+			watts[i-1] = NAN;
+
+		last_energy_count = energy_count;
+		last_sample_count = sample_count;
+		last_valid = true;
+		}
+	return count - 1;
+	}
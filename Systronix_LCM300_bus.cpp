@@ -0,0 +1,343 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_bus.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.6	2026Oct16 discover() registers every supply, absent ones for background re-probe; rack writes skip absent supplies
+	v0.5	2026Oct16 discover(): probe every address, then read identity of all present supplies interleaved
+	v0.4	2026Oct16 retries, backoff, and re-probes per Systronix_LCM300::recovery_set()
+	v0.3	2026Oct16 stats_reset() and utilization() across the net
+	v0.2	2026Oct16 rack-wide vout_set() and margin_set() with one shared read-back interval
+	v0.1	2026Oct16 start; interleaves command reads across all LCM300 on one Wire net
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_bus.h>
+
+
+//---------------------------< A D D >------------------------------------------------------------------------
+/*!
+	@brief	Register a supply that has been setup() and begin()'d.  Supplies must all use the same Wire net
+			and must have unique addresses.
+	@return	SUCCESS, or FAIL when the list is full, the address is already registered, or the Wire net name
+			doesn't match the first registered supply
+*/
+
+uint8_t Systronix_LCM300_bus::add (Systronix_LCM300& dev)
+	{
+	uint8_t	i;
+
+	if (LCM300_BUS_MAX_DEVICES <= _dev_count)
+		return FAIL;
+
+	for (i=0; i<_dev_count; i++)
+		{
+		if (_dev[i]->base_get() == dev.base_get())
+			return FAIL;								// two supplies at one address?
+		}
+
+	if (_dev_count && strcmp (_dev[0]->wire_name, dev.wire_name))
+		return FAIL;									// a different Wire net
+
+	_dev[_dev_count++] = &dev;
+	return SUCCESS;
+	}
+
+
+//---------------------------< D I S C O V E R >--------------------------------------------------------------
+/*!
+	@brief	Startup in one pass, in place of init() one supply at a time.  dev[0..count) have been setup() with
+			this net's transport at their addresses and begin()'d; typically one for each of 0x58 - 0x5F.  Each is
+			probed with its address alone (Systronix_LCM300::probe(): no command, no interval wait, short
+			timeout), so empty slots cost about 100us each.  All are add()ed; those that answer have VOUT_MODE,
+			and with read_identity the rest of LCM300_IDENTITY_MASK, queued, and all of it is then read
+			interleaved, so the 50ms communication intervals of different supplies overlap instead of adding up.
+
+			Those that didn't answer, or answered the probe but not VOUT_MODE, are registered but absent
+			(error.exists false), as after a failed init(); recovery re-probes them in the background, so a
+			supply plugged into an empty slot later is found and its identity read without another discover().
+	@return	the number of supplies ready: present, registered and with VOUT_MODE read
+*/
+
+uint8_t Systronix_LCM300_bus::discover (Systronix_LCM300* dev, uint8_t count, bool read_identity)
+	{
+	uint8_t	i;
+	uint8_t	ready = 0;
+	bool	present;
+
+	for (i=0; i<count; i++)
+		{
+		present = (SUCCESS == dev[i].probe());
+		if ((SUCCESS != add (dev[i])) || !present)			// every one registered, present or not
+			continue;
+		dev[i].command_queue_mask ((read_identity ? LCM300_IDENTITY_MASK : CMD_MASK(VOUT_MODE_CMD)) & ~dev[i].identity.valid);
+		}
+
+	run ();													// VOUT_MODE is cmd[] index 0 so it is read first
+
+	for (i=0; i<count; i++)
+		{
+		if (!dev[i].error.exists)
+			continue;
+		if (dev[i].identity.valid & CMD_MASK(VOUT_MODE_CMD))
+			ready++;
+		else
+			dev[i].error.exists = false;					// as init()
+		}
+	return ready;
+	}
+
+
+//---------------------------< C O U N T >--------------------------------------------------------------------
+
+uint8_t Systronix_LCM300_bus::count (void)
+	{
+	return _dev_count;
+	}
+
+
+//---------------------------< D E V I C E _ G E T >----------------------------------------------------------
+
+Systronix_LCM300* Systronix_LCM300_bus::device_get (uint8_t index)
+	{
+	return (index < _dev_count) ? _dev[index] : NULL;
+	}
+
+
+//---------------------------< C A L L B A C K _ S E T >------------------------------------------------------
+//
+// done_cb is called from tick() when each queued command completes, with the instance, the cmd[] index, and the
+// result (SUCCESS or FAIL).  For SUCCESS, the response is in dev->response_last().  NULL for no callback.
+//
+
+void Systronix_LCM300_bus::callback_set (lcm300_done_cb_t done_cb)
+	{
+	_done_cb = done_cb;
+	}
+
+
+//---------------------------< Q U E U E >--------------------------------------------------------------------
+
+void Systronix_LCM300_bus::queue (int cmd_idx)
+	{
+	for (uint8_t i=0; i<_dev_count; i++)
+		_dev[i]->command_queue (cmd_idx);
+	}
+
+
+void Systronix_LCM300_bus::queue_mask (uint32_t mask)
+	{
+	for (uint8_t i=0; i<_dev_count; i++)
+		_dev[i]->command_queue_mask (mask);
+	}
+
+
+//---------------------------< T I C K >----------------------------------------------------------------------
+/*!
+	@brief	Call often.  Advances the transaction in progress, if any; when it completes, reports it through
+			the callback and then starts a queued command on the next supply, round-robin, whose communication
+			interval has elapsed.  Supplies still in their interval are passed over so the bus is never idle
+			when some supply could use it.  Queued commands for absent supplies are discarded.  Also sends the
+			fault monitor's pending CLEAR_FAULTS (Systronix_LCM300::fault_clear_service()).
+
+			Recovery (Systronix_LCM300::recovery_set()): a failed command is queued again and its supply held
+			for a backoff while the others carry on; the callback sees only the final result.  An absent
+			supply is re-probed when its backoff is up and the bus is free; re-probes are not reported and
+			don't count as work for run() or idle().
+	@return	LCM300_PENDING while a transaction is in progress or commands remain queued, else SUCCESS
+*/
+
+uint8_t Systronix_LCM300_bus::tick (void)
+	{
+	uint8_t				ret_val;
+	uint8_t				i;
+	uint8_t				dev_idx;
+	bool				queued = false;
+	Systronix_LCM300*	dev;
+
+	if (_busy)
+		{
+		dev = _dev[_active];
+		ret_val = dev->command_poll();
+		if (LCM300_PENDING == ret_val)
+			return LCM300_PENDING;
+
+		_busy = false;
+		ret_val = dev->recovery_result (ret_val);	// retry, re-probe, stuck bus
+		if (_done_cb && (LCM300_PENDING != ret_val))
+			_done_cb (dev, dev->command_idx_get(), ret_val);
+		}
+
+	for (i=0; i<_dev_count; i++)
+		{
+		dev_idx = (_next + i) % _dev_count;
+		dev = _dev[dev_idx];
+
+		if (dev->fault_clear_pending())
+			{
+			queued = true;
+			dev->fault_clear_service();				// only once this supply is free; a short blocking write
+			}
+
+		if (!dev->error.exists)
+			{
+			dev->command_queue_clear();				// nothing to talk to
+			if (dev->recovery_probe_due() && !dev->interval_remaining() && (SUCCESS == dev->recovery_probe_start()))
+				{
+				_active = dev_idx;
+				_busy = true;
+				_next = (dev_idx + 1) % _dev_count;
+				return LCM300_PENDING;
+				}
+			continue;
+			}
+
+		if (!dev->command_queued())
+			continue;
+
+		queued = true;
+		if (dev->interval_remaining() || dev->command_busy() || dev->recovery_holding())
+			continue;								// not this one yet
+
+		ret_val = dev->command_start (dev->command_dequeue());
+		if (SUCCESS != ret_val)
+			continue;
+
+		dev->command_poll();						// interval has elapsed so this puts the command byte on the bus
+		_active = dev_idx;
+		_busy = true;
+		_next = (dev_idx + 1) % _dev_count;			// next time, start looking at the supply after this one
+		return LCM300_PENDING;
+		}
+
+	return queued ? LCM300_PENDING : SUCCESS;
+	}
+
+
+//---------------------------< I D L E >----------------------------------------------------------------------
+
+bool Systronix_LCM300_bus::idle (void)
+	{
+	if (_busy)
+		return false;
+
+	for (uint8_t i=0; i<_dev_count; i++)
+		{
+		if (_dev[i]->error.exists && (_dev[i]->command_queued() || _dev[i]->fault_clear_pending()))
+			return false;
+		}
+	return true;
+	}
+
+
+//---------------------------< R U N >------------------------------------------------------------------------
+//
+// Blocking: tick() until every queued command has been read.
+//
+
+uint8_t Systronix_LCM300_bus::run (void)
+	{
+	while (LCM300_PENDING == tick());
+	return SUCCESS;
+	}
+
+
+//---------------------------< P O L L _ T E L E M E T R Y >--------------------------------------------------
+//
+// Call from loop() in place of tick().  Queues a telemetry sweep on each supply when its period has elapsed (see
+// Systronix_LCM300::telemetry_set()) then ticks.  Sweeps of all supplies are interleaved like any other queued
+// commands; read the results from each supply's snapshot().
+//
+
+uint8_t Systronix_LCM300_bus::poll_telemetry (void)
+	{
+	for (uint8_t i=0; i<_dev_count; i++)
+		_dev[i]->telemetry_schedule();
+
+	return tick();
+	}
+
+
+//---------------------------< V O U T _ S E T >--------------------------------------------------------------
+//
+// Blocking: Systronix_LCM300::vout_set() on every present supply.  All the writes go out first, then all the read
+// backs, so the whole rack waits out one communication interval between write and verify instead of one per
+// supply.  Finishes whatever is queued first.  Absent supplies are passed over.
+//
+// @return SUCCESS when every present supply took the new voltage, else FAIL; see each supply's output counters
+//
+
+uint8_t Systronix_LCM300_bus::vout_set (float volts)
+	{
+	uint8_t	ret_val = SUCCESS;
+
+	run ();
+	for (uint8_t i=0; i<_dev_count; i++)
+		{
+		if (_dev[i]->error.exists && (SUCCESS != _dev[i]->vout_set (volts, false)))
+			ret_val = FAIL;
+		}
+	return write_verify_all (ret_val);
+	}
+
+
+//---------------------------< M A R G I N _ S E T >----------------------------------------------------------
+//
+// Blocking: Systronix_LCM300::margin_set() on every present supply, writes first then read backs as for
+// vout_set().
+//
+// @return SUCCESS when every present supply is at the new margin, else FAIL
+//
+
+uint8_t Systronix_LCM300_bus::margin_set (int8_t direction)
+	{
+	uint8_t	ret_val = SUCCESS;
+
+	run ();
+	for (uint8_t i=0; i<_dev_count; i++)
+		{
+		if (_dev[i]->error.exists && (SUCCESS != _dev[i]->margin_set (direction, false)))
+			ret_val = FAIL;
+		}
+	return write_verify_all (ret_val);
+	}
+
+
+//---------------------------< S T A T S _ R E S E T ,   U T I L I Z A T I O N >------------------------------
+//
+// One transaction at a time on the net, so its utilization is the sum of its supplies'.  Only the supplies
+// registered here with stats_attach()'d stats count; other devices on the same net are not seen.
+//
+
+void Systronix_LCM300_bus::stats_reset (void)
+	{
+	for (uint8_t i=0; i<_dev_count; i++)
+		_dev[i]->stats_reset ();
+	}
+
+
+float Systronix_LCM300_bus::utilization (void)
+	{
+	float	sum = 0;
+
+	for (uint8_t i=0; i<_dev_count; i++)
+		sum += _dev[i]->stats_utilization ();
+	return sum;
+	}
+
+
+//---------------------------< W R I T E _ V E R I F Y _ A L L >----------------------------------------------
+
+uint8_t Systronix_LCM300_bus::write_verify_all (uint8_t ret_val)
+	{
+	for (uint8_t i=0; i<_dev_count; i++)
+		{
+		if (_dev[i]->error.exists && (SUCCESS != _dev[i]->write_verify ()))
+			ret_val = FAIL;
+		}
+	return ret_val;
+	}
@@ -0,0 +1,95 @@
+#ifndef SYSTRONIX_LCM300_BUS_h
+#define SYSTRONIX_LCM300_BUS_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_bus.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.5	2026Oct16 discover() registers every supply, absent ones for background re-probe; rack writes skip absent supplies
+	v0.4	2026Oct16 discover(): probe every address, then read identity of all present supplies interleaved
+	v0.3	2026Oct16 stats_reset() and utilization() across the net
+	v0.2	2026Oct16 rack-wide vout_set() and margin_set() with one shared read-back interval
+	v0.1	2026Oct16 start; interleaves command reads across all LCM300 on one Wire net
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Each LCM300 must be left alone for LCM300_CMD_INTERVAL_US (50 ms) after every transaction; the
+	transaction itself takes only a millisecond or two at 100 kHz.  Reading N supplies one after the
+	other wastes the bus for almost all of N * 50 ms per command.
+
+	Systronix_LCM300_bus keeps a list of the Systronix_LCM300 instances on one Wire net and, each time
+	tick() is called, starts the next queued command on whichever supply is out of its quiet interval.
+	While supply A is waiting, the bus is talking to supply B.  A sweep of the same commands across
+	eight supplies takes about as long as the sweep of one.
+
+	At startup, discover() does the same for init(): a quick address-only probe of each slot, then
+	VOUT_MODE and the identity of every supply that answered, interleaved.  An eight-slot shelf is
+	ready to poll in about the time init() takes for one supply.  Every slot is registered, so empty
+	ones are re-probed in the background and a supply plugged in later is found by itself; count()
+	and device_get() include absent supplies (error.exists false).
+
+	Rules:
+	- all registered instances must have been setup() with the same Wire net (the same transport)
+	- once registered, don't call command_read() / command_start() on an instance directly; queue
+	  commands with Systronix_LCM300::command_queue() or Systronix_LCM300_bus::queue() instead
+	- the response to each command is in that instance's response_last() in the done callback, and
+	  in its response ring (response_find()), if response_ring_set() gave it one, until the ring has
+	  gone round once more
+***************************************************************************************************/
+
+
+#include <Systronix_LCM300.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#define		LCM300_BUS_MAX_DEVICES	(LCM300_BASE_MAX - LCM300_BASE_MIN + 1)		// eight addresses 0x58 - 0x5F
+
+typedef void (*lcm300_done_cb_t) (Systronix_LCM300* dev, int cmd_idx, uint8_t result);	// called when each queued command completes
+
+
+class Systronix_LCM300_bus
+	{
+	protected:
+		Systronix_LCM300*	_dev[LCM300_BUS_MAX_DEVICES];	// registered supplies
+		uint8_t		_dev_count = 0;
+		uint8_t		_active;								// _dev[] index of supply that has the bus; only valid when _busy
+		bool		_busy = false;							// a transaction is in progress
+		uint8_t		_next = 0;								// round-robin: _dev[] index to consider first
+
+		lcm300_done_cb_t	_done_cb = NULL;
+
+		uint8_t		write_verify_all (uint8_t ret_val);
+
+	public:
+		uint8_t		add (Systronix_LCM300& dev);			// register a supply; SUCCESS or FAIL
+		uint8_t		discover (Systronix_LCM300* dev, uint8_t count, bool read_identity=true);	// blocking: probe and add all, init the present ones; how many
+		uint8_t		count (void);							// number of registered supplies
+		Systronix_LCM300*	device_get (uint8_t index);		// registered supply by registration order; NULL if none
+
+		void		callback_set (lcm300_done_cb_t done_cb);	// called with each completed command
+
+		void		queue (int cmd_idx);					// queue a command on all registered supplies
+		void		queue_mask (uint32_t mask);				// queue several commands on all registered supplies
+
+		uint8_t		tick (void);							// call from loop(); LCM300_PENDING while any work remains else SUCCESS
+		bool		idle (void);							// nothing in flight and nothing queued
+		uint8_t		run (void);								// blocking: tick() until idle
+
+		uint8_t		poll_telemetry (void);					// call from loop(); keeps every supply's telemetry snapshot current
+
+		uint8_t		vout_set (float volts);					// blocking: every present supply's VOUT_COMMAND, verified; SUCCESS or FAIL
+		uint8_t		margin_set (int8_t direction);			// blocking: every present supply's OPERATION, verified; SUCCESS or FAIL
+
+		void		stats_reset (void);						// every supply's stats
+		float		utilization (void);						// fraction of the time since stats_reset() the net was busy
+	};
+
+#endif /* SYSTRONIX_LCM300_BUS_h */
@@ -0,0 +1,120 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_log.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; compact binary telemetry log records
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_log.h>
+
+
+//---------------------------< H E A D E R >------------------------------------------------------------------
+//
+// The log header.  Also starts the record stream over: the next sample is preceded by a sync.
+//
+
+size_t Systronix_LCM300_log::header (uint8_t* buf)
+	{
+	memcpy (buf, "LCM300", 6);
+	buf[6] = LCM300_LOG_VERSION;
+	buf[7] = 0;
+	sync();
+	byte_count += LCM300_LOG_HEADER_SIZE;
+	return LCM300_LOG_HEADER_SIZE;
+	}
+
+
+//---------------------------< S A M P L E >------------------------------------------------------------------
+/*!
+	@brief	Build the record for one raw response from the supply at base, read at micros() us, preceded by a
+			sync when one is due.  Samples must be given in time order.
+	@return	bytes written to buf, at most LCM300_LOG_RECORD_MAX; 0 when base is not an LCM300 address or
+			cmd_idx is not a byte or word command
+*/
+
+size_t Systronix_LCM300_log::sample (uint8_t* buf, uint8_t base, int cmd_idx, uint16_t raw, uint32_t us)
+	{
+	uint8_t*	p = buf;
+	uint32_t	dt = us - _last_us;
+
+	if ((LCM300_BASE_MIN > base) || (LCM300_BASE_MAX < base) ||
+		(0 > cmd_idx) || (CMD_ARRAY_SIZE <= cmd_idx) || (LCM300_LOG_BLOCK_CMDS & CMD_MASK(cmd_idx)))
+		return 0;
+
+	if ((LCM300_LOG_SYNC_EVERY <= _since_sync) || (LCM300_LOG_DT_MAX < dt))
+		{
+		*p++ = LCM300_LOG_SYNC_TAG;
+		*p++ = LCM300_LOG_SYNC_MARK;
+		*p++ = (uint8_t)us;
+		*p++ = (uint8_t)(us >> 8);
+		*p++ = (uint8_t)(us >> 16);
+		*p++ = (uint8_t)(us >> 24);
+		_since_sync = 0;
+		dt = 0;
+		}
+
+	*p++ = (uint8_t)(((base - LCM300_BASE_MIN) << 5) | cmd_idx);
+
+	while (0x7F < dt)
+		{
+		*p++ = 0x80 | (dt & 0x7F);
+		dt >>= 7;
+		}
+	*p++ = (uint8_t)dt;
+
+	*p++ = (uint8_t)raw;
+	if (!(LCM300_LOG_BYTE_CMDS & CMD_MASK(cmd_idx)))
+		*p++ = (uint8_t)(raw >> 8);
+
+	_last_us = us;
+	_since_sync++;
+	record_count++;
+	byte_count += p - buf;
+	return p - buf;
+	}
+
+
+//---------------------------< R E S P O N S E >--------------------------------------------------------------
+//
+// sample() for a completed command_start() read, e.g. dev->response_last() in a Systronix_LCM300_bus callback.
+// Failed reads are not logged (returns 0).
+//
+
+size_t Systronix_LCM300_log::response (uint8_t* buf, Systronix_LCM300& dev, const Systronix_LCM300::response_t* response)
+	{
+	uint16_t	raw;
+
+	if (!response || (SUCCESS != response->result))
+		return 0;
+
+	raw = (LCM300_LOG_BYTE_CMDS & CMD_MASK(response->cmd_idx)) ? response->data.as_byte : response->data.as_word;
+	return sample (buf, dev.base_get(), response->cmd_idx, raw, response->us);
+	}
+
+
+//---------------------------< S T R E A M _ S A M P L E >----------------------------------------------------
+//
+// sample() for a sample drained from a Systronix_LCM300_stream of the supply at base.  A sample that follows
+// dropped samples (LCM300_STREAM_GAP) gets a sync, which marks the spot in the log.
+//
+
+size_t Systronix_LCM300_log::stream_sample (uint8_t* buf, uint8_t base, const lcm300_sample_t& sample)
+	{
+	if (sample.flags & LCM300_STREAM_GAP)
+		sync();
+	return this->sample (buf, base, sample.cmd_idx, sample.raw, sample.us);
+	}
+
+
+//---------------------------< S Y N C >----------------------------------------------------------------------
+
+void Systronix_LCM300_log::sync (void)
+	{
+	_since_sync = LCM300_LOG_SYNC_EVERY;
+	}
@@ -0,0 +1,90 @@
+#ifndef SYSTRONIX_LCM300_LOG_h
+#define SYSTRONIX_LCM300_LOG_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_log.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; compact binary telemetry log records
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Compact binary log of raw LCM300 responses, for shelves that log telemetry to Serial or SD.  A
+	printf of a decoded reading is 15 - 30 characters; the same reading here is 4 or 5 bytes, and the
+	raw word is kept so nothing is lost to rounding.  Decoding happens later, on a PC: see
+	extras/host/lcm300_log2csv.
+
+	Systronix_LCM300_log only builds records into a caller's buffer; write them wherever they go
+	(Serial.write(), an SD file, ...).  All multi-byte fields are little endian.
+
+	header		once, at the start of a log:
+					'L' 'C' 'M' '3' '0' '0' LCM300_LOG_VERSION 0
+
+	sample		one response:
+					tag			(address - 0x58) << 5 | cmd[] index
+					dt			microseconds since the previous record; 1 - 3 bytes, 7 bits per byte,
+								least significant first, msb set on all but the last byte
+					raw			1 byte for byte commands (LCM300_LOG_BYTE_CMDS), else 2
+
+	sync		absolute time; before the first sample, every LCM300_LOG_SYNC_EVERY samples, and whenever
+				dt would not fit in 3 bytes:
+					LCM300_LOG_SYNC_TAG LCM300_LOG_SYNC_MARK micros() (4 bytes)
+
+	cmd[] indexes only go to 25 so tags with 26 - 31 in the low five bits are never samples; 0x1F is
+	the sync tag and the rest are reserved.  A decoder that finds a reserved tag has lost its place
+	and can scan ahead for the next sync.  VOUT_MODE is logged like any byte command; the decoder
+	takes each supply's linear-16 exponent for Vout from it, so log it (log.response() after
+	init(), or identity) before any Vout readings.  Block commands (ascii, READ_EOUT) are not logged.
+***************************************************************************************************/
+
+
+#include <Systronix_LCM300.h>
+#include <Systronix_LCM300_stream.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#define		LCM300_LOG_VERSION		1
+#define		LCM300_LOG_HEADER_SIZE	8
+#define		LCM300_LOG_SYNC_TAG		0x1F
+#define		LCM300_LOG_SYNC_MARK	0xA5
+#define		LCM300_LOG_SYNC_SIZE	6
+#define		LCM300_LOG_SYNC_EVERY	64				// samples between syncs; bounds what is lost to a damaged byte
+#define		LCM300_LOG_DT_MAX		((1UL << 21) - 1)	// largest dt in 3 bytes
+#define		LCM300_LOG_RECORD_MAX	(LCM300_LOG_SYNC_SIZE + 1 + 3 + 2)	// most bytes sample() can write
+
+#define		LCM300_LOG_BYTE_CMDS	(CMD_MASK(VOUT_MODE_CMD) | CMD_MASK(PMBUS_REVISION_CMD) | CMD_MASK(STATUS_BYTE_CMD) |	\
+									CMD_MASK(STATUS_VOUT_CMD) | CMD_MASK(STATUS_IOUT_CMD) | CMD_MASK(STATUS_TEMP_CMD) |		\
+										CMD_MASK(OPERATION_CMD) | CMD_MASK(WRITE_PROTECT_CMD))
+#define		LCM300_LOG_BLOCK_CMDS	(CMD_MASK(READ_EOUT_CMD) | CMD_MASK(MFR_ID_CMD) | CMD_MASK(MFR_MODEL_CMD) |			\
+									CMD_MASK(MFR_REVISION_CMD) | CMD_MASK(MFR_LOCATION_CMD) | CMD_MASK(MFR_DATE_CMD) |	\
+									CMD_MASK(MFR_SERIAL_CMD))
+
+static_assert (CMD_ARRAY_SIZE <= LCM300_LOG_SYNC_TAG, "cmd[] indexes must leave room for the log sync tag");
+
+
+class Systronix_LCM300_log
+	{
+	protected:
+		uint32_t	_last_us = 0;							// time of the previous record
+		uint16_t	_since_sync = LCM300_LOG_SYNC_EVERY;	// samples since the last sync; starts out due
+
+	public:
+		uint32_t	record_count = 0;						// samples written
+		uint32_t	byte_count = 0;							// bytes written, header and syncs included
+
+		size_t		header (uint8_t* buf);					// LCM300_LOG_HEADER_SIZE bytes
+		size_t		sample (uint8_t* buf, uint8_t base, int cmd_idx, uint16_t raw, uint32_t us);	// up to LCM300_LOG_RECORD_MAX bytes
+		size_t		response (uint8_t* buf, Systronix_LCM300& dev, const Systronix_LCM300::response_t* response);
+		size_t		stream_sample (uint8_t* buf, uint8_t base, const lcm300_sample_t& sample);
+		void		sync (void);							// sync before the next sample, e.g. after log bytes were lost
+	};
+
+#endif /* SYSTRONIX_LCM300_LOG_h */
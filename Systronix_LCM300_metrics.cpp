@@ -0,0 +1,374 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_metrics.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; per-supply streaming min / max / mean / variance / EWMA / quantiles
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_metrics.h>
+
+
+const uint32_t	Systronix_LCM300_metrics::_window_ms[LCM300_METRIC_WINDOWS] = {1000, 60000, 3600000};
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+//
+// Statistics of dev, from now.  Values already in the snapshot are not sampled; the next reads are.
+//
+
+void Systronix_LCM300_metrics::begin (Systronix_LCM300& dev)
+	{
+	_dev = &dev;
+	reset();
+	}
+
+
+//---------------------------< R E S E T >--------------------------------------------------------------------
+
+void Systronix_LCM300_metrics::reset (void)
+	{
+	uint32_t	now = millis();
+	uint8_t		m;
+	uint8_t		w;
+
+	for (m=0; m<METRICS; m++)
+		{
+		for (w=0; w<LCM300_METRIC_WINDOWS; w++)
+			{
+			window_start (_metric[m].window[w], now);
+			memset (&_metric[m].window[w].last, 0, sizeof(summary_t));
+			}
+		_metric[m].ewma = 0;
+		_metric[m].ewma_ms = now;
+		_metric[m].ewma_valid = false;
+		_read_ms[m] = _dev ? _dev->telemetry.read_ms[m] : 0;
+		}
+	sample_count = 0;
+	}
+
+
+//---------------------------< U P D A T E >------------------------------------------------------------------
+/*!
+	@brief	Sample every metric the snapshot has a newer read of than last time, at the time of that read, then
+			close any windows that have ended.
+	@return	number of samples taken
+*/
+
+uint8_t Systronix_LCM300_metrics::update (void)
+	{
+	const Systronix_LCM300::telemetry_t&	t = _dev->telemetry;
+	uint8_t		count = 0;
+	uint8_t		m;
+	float		value;
+
+	for (m=0; m<METRICS; m++)
+		{
+		if (t.read_ms[m] == _read_ms[m])					// not read since last time
+			continue;
+
+		switch (m)
+			{
+			case VOUT:		value = t.vout;				break;
+			case IOUT:		value = t.iout;				break;
+			case POUT:		value = t.pout;				break;
+			case TEMP_2:	value = t.temperature_2;	break;
+			default:		value = t.fan_speed;		break;
+			}
+		_read_ms[m] = t.read_ms[m];
+		sample (m, value, t.read_ms[m]);
+		count++;
+		}
+
+	roll (millis());
+	return count;
+	}
+
+
+//---------------------------< S A M P L E >------------------------------------------------------------------
+//
+// Fold one value, read at millis() ms, into every window of metric and its EWMA.  Samples must come in time
+// order; one older than the window it would land in goes into the window in progress anyway.
+//
+
+void Systronix_LCM300_metrics::sample (uint8_t metric, float value, uint32_t ms)
+	{
+	metric_t&	mt = _metric[metric];
+	float		delta;
+	uint32_t	dt;
+	uint8_t		w;
+	uint8_t		i;
+
+	roll_metric (mt, ms);
+
+	for (w=0; w<LCM300_METRIC_WINDOWS; w++)
+		{
+		window_t&	win = mt.window[w];
+		summary_t&	s = win.current;
+
+		s.count++;
+		delta = value - s.mean;								// Welford
+		s.mean += delta / s.count;
+		s.m2 += delta * (value - s.mean);
+
+		if ((1 == s.count) || (value < s.min))
+			{
+			s.min = value;
+			s.min_ms = ms;
+			}
+		if ((1 == s.count) || (value > s.max))
+			{
+			s.max = value;
+			s.max_ms = ms;
+			}
+
+		for (i=0; i<LCM300_METRIC_QUANTILES; i++)
+			p2_add (win.p2[i], _p[i], s.count, value);
+		}
+
+	if (!mt.ewma_valid)
+		{
+		mt.ewma = value;
+		mt.ewma_valid = true;
+		}
+	else
+		{
+		dt = ms - mt.ewma_ms;								// weight dt / (tau + dt): 1 - e^(-dt/tau) without the exp
+		mt.ewma += (value - mt.ewma) * ((float)dt / (_tau_ms + dt));
+		}
+	mt.ewma_ms = ms;
+	sample_count++;
+	}
+
+
+//---------------------------< R O L L >----------------------------------------------------------------------
+//
+// Close every window that ended at or before ms: its summary becomes last() and a new one starts on the window
+// boundary.  A window with no samples in it still rolls, so last() of a supply that stopped answering empties.
+//
+
+void Systronix_LCM300_metrics::roll (uint32_t ms)
+	{
+	for (uint8_t m=0; m<METRICS; m++)
+		roll_metric (_metric[m], ms);
+	}
+
+
+void Systronix_LCM300_metrics::roll_metric (metric_t& mt, uint32_t ms)
+	{
+	uint32_t	elapsed;
+	uint8_t		w;
+	uint8_t		i;
+
+	for (w=0; w<LCM300_METRIC_WINDOWS; w++)
+		{
+		window_t&	win = mt.window[w];
+
+		elapsed = ms - win.current.start_ms;
+		if ((int32_t)elapsed < (int32_t)_window_ms[w])
+			continue;
+
+		for (i=0; i<LCM300_METRIC_QUANTILES; i++)
+			win.current.quantile[i] = p2_get (win.p2[i], _p[i], win.current.count);
+		win.last = win.current;
+		window_start (win, ms - (elapsed % _window_ms[w]));	// a whole number of windows after the last start
+		}
+	}
+
+
+//---------------------------< W I N D O W _ S T A R T >------------------------------------------------------
+
+void Systronix_LCM300_metrics::window_start (window_t& w, uint32_t start_ms)
+	{
+	memset (&w.current, 0, sizeof(summary_t));
+	memset (w.p2, 0, sizeof(w.p2));
+	w.current.start_ms = start_ms;
+	}
+
+
+//---------------------------< C U R R E N T ,   L A S T >----------------------------------------------------
+
+const Systronix_LCM300_metrics::summary_t& Systronix_LCM300_metrics::current (uint8_t metric, uint8_t window)
+	{
+	window_t&	win = _metric[metric].window[window];
+
+	for (uint8_t i=0; i<LCM300_METRIC_QUANTILES; i++)
+		win.current.quantile[i] = p2_get (win.p2[i], _p[i], win.current.count);
+	return win.current;
+	}
+
+
+const Systronix_LCM300_metrics::summary_t& Systronix_LCM300_metrics::last (uint8_t metric, uint8_t window)
+	{
+	return _metric[metric].window[window].last;
+	}
+
+
+//---------------------------< E W M A _ S E T ,   Q U A N T I L E _ S E T >----------------------------------
+
+void Systronix_LCM300_metrics::ewma_set (uint32_t tau_ms)
+	{
+	_tau_ms = tau_ms ? tau_ms : 1;
+	}
+
+
+void Systronix_LCM300_metrics::quantile_set (uint8_t index, float p)
+	{
+	if ((LCM300_METRIC_QUANTILES <= index) || (0 > p) || (1 < p))
+		return;
+	_p[index] = p;
+	reset();												// markers placed for the old p are no use
+	}
+
+
+//---------------------------< P 2 _ A D D >------------------------------------------------------------------
+//
+// P-square: add the count'th value.  The first five are kept, sorted, as the marker heights.  After that the
+// five markers track the min, p/2, p, (1+p)/2 and max quantiles: each new value moves the positions of the
+// markers above it, and the three middle markers that are a position or more from where they should be step
+// one position toward it, their heights adjusted by a parabola through their neighbours (or a straight line
+// when the parabola would put them out of order).
+//
+
+void Systronix_LCM300_metrics::p2_add (p2_t& p2, float p, uint32_t count, float value)
+	{
+	float		desired;
+	float		d;
+	float		q;
+	int32_t		ds;
+	uint8_t		k;
+	uint8_t		i;
+
+	if (5 >= count)
+		{
+		for (i=count-1; (0 < i) && (p2.q[i-1] > value); i--)	// insertion sort
+			p2.q[i] = p2.q[i-1];
+		p2.q[i] = value;
+		if (5 == count)
+			{
+			for (i=0; i<5; i++)
+				p2.n[i] = i;
+			}
+		return;
+		}
+
+	if (value < p2.q[0])									// the marker cell value falls in
+		{
+		p2.q[0] = value;
+		k = 0;
+		}
+	else if (value >= p2.q[4])
+		{
+		p2.q[4] = value;
+		k = 3;
+		}
+	else
+		{
+		for (k=0; value >= p2.q[k+1]; k++)
+			;
+		}
+
+	for (i=k+1; i<5; i++)
+		p2.n[i]++;
+
+	for (i=1; i<4; i++)
+		{
+		switch (i)											// where marker i should be now
+			{
+			case 1:		desired = (count - 1) * p / 2;			break;
+			case 2:		desired = (count - 1) * p;				break;
+			default:	desired = (count - 1) * (1 + p) / 2;	break;
+			}
+		d = desired - p2.n[i];
+
+		if (((1 <= d) && (1 < p2.n[i+1] - p2.n[i])) || ((-1 >= d) && (-1 > p2.n[i-1] - p2.n[i])))
+			{
+			ds = (0 < d) ? 1 : -1;
+			q = p2.q[i] + (float)ds / (p2.n[i+1] - p2.n[i-1]) *		// parabolic
+				((p2.n[i] - p2.n[i-1] + ds) * (p2.q[i+1] - p2.q[i]) / (p2.n[i+1] - p2.n[i]) +
+				(p2.n[i+1] - p2.n[i] - ds) * (p2.q[i] - p2.q[i-1]) / (p2.n[i] - p2.n[i-1]));
+			if ((p2.q[i-1] >= q) || (q >= p2.q[i+1]))				// out of order: linear
+				q = p2.q[i] + ds * (p2.q[i+ds] - p2.q[i]) / (p2.n[i+ds] - p2.n[i]);
+			p2.q[i] = q;
+			p2.n[i] += ds;
+			}
+		}
+	}
+
+
+//---------------------------< P 2 _ G E T >------------------------------------------------------------------
+//
+// The p quantile of count values: the middle marker, or for five or fewer the nearest of the sorted values.
+//
+
+float Systronix_LCM300_metrics::p2_get (const p2_t& p2, float p, uint32_t count)
+	{
+	if (0 == count)
+		return 0;
+	if (5 >= count)
+		return p2.q[(uint8_t)((count - 1) * p + 0.5f)];
+	return p2.q[2];
+	}
+
+
+//---------------------------< V A R I A N C E ,   S T D D E V >----------------------------------------------
+
+float Systronix_LCM300_metrics::variance (const summary_t& s)
+	{
+	return (2 > s.count) ? 0 : s.m2 / (s.count - 1);
+	}
+
+
+float Systronix_LCM300_metrics::stddev (const summary_t& s)
+	{
+	return sqrtf (variance (s));
+	}
+
+
+//---------------------------< M E R G E >--------------------------------------------------------------------
+//
+// Combine from into into as if into had seen from's samples too (Chan et al.); start_ms becomes the earlier of
+// the two.  Quantiles can't be merged exactly from their estimates; they are weighted by count.
+//
+
+void Systronix_LCM300_metrics::merge (summary_t& into, const summary_t& from)
+	{
+	uint32_t	count = into.count + from.count;
+	float		delta;
+	uint8_t		i;
+
+	if (0 == from.count)
+		return;
+	if (0 == into.count)
+		{
+		into = from;
+		return;
+		}
+
+	delta = from.mean - into.mean;
+	into.m2 += from.m2 + delta * delta * ((float)into.count * from.count / count);
+	into.mean += delta * from.count / count;
+
+	if (from.min < into.min)
+		{
+		into.min = from.min;
+		into.min_ms = from.min_ms;
+		}
+	if (from.max > into.max)
+		{
+		into.max = from.max;
+		into.max_ms = from.max_ms;
+		}
+
+	for (i=0; i<LCM300_METRIC_QUANTILES; i++)
+		into.quantile[i] = (into.quantile[i] * into.count + from.quantile[i] * from.count) / count;
+
+	if ((int32_t)(from.start_ms - into.start_ms) < 0)
+		into.start_ms = from.start_ms;
+	into.count = count;
+	}
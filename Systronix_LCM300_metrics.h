@@ -0,0 +1,137 @@
+#ifndef SYSTRONIX_LCM300_METRICS_h
+#define SYSTRONIX_LCM300_METRICS_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_metrics.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; per-supply streaming min / max / mean / variance / EWMA / quantiles
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Dashboard statistics of one supply's Vout, Iout, Pout, temperature and fan speed over 1 second,
+	1 minute and 1 hour windows, in constant memory: no samples are kept.  Each sample costs the same
+	few dozen float operations however long the window:
+
+	- count, mean and variance by Welford's method
+	- min and max, with the millis() of each
+	- quantiles (default median and 95th percentile) by the P-square algorithm (Jain & Chlamtac,
+	  1985): five markers per quantile, moved with a parabolic fit as samples arrive; exact for the
+	  first five samples, typically within a few percent of the true quantile after that
+	- an exponentially weighted moving average with a time constant, not a per-sample weight, so it
+	  means the same thing when the adaptive scheduler slows a metric down
+
+	Windows are tumbling, aligned to when begin() was called: when one ends its summary moves to
+	last() and a new one starts.  current() is the window in progress.  merge() combines summaries
+	(count, mean and variance exactly, min and max, quantiles as a count-weighted average) to roll
+	them up further: a day from hours, or a rack from its supplies.
+
+	Samples come from the supply's telemetry snapshot, which every successful read updates no matter
+	who asked for it (poll_telemetry(), Systronix_LCM300_bus, the scheduler, command_read()).  Call
+	update() at least as often as the fastest metric is read, e.g. from loop() or the bus done
+	callback; a field read twice between update() calls contributes its newer value only.  Or feed
+	sample() directly.
+
+	Memory: about 2.4 KB per supply at the defaults (5 metrics x 3 windows, 2 quantiles).
+***************************************************************************************************/
+
+
+#include <Systronix_LCM300.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#define		LCM300_METRIC_WINDOWS		3				// 1 s, 1 min, 1 h
+#ifndef		LCM300_METRIC_QUANTILES
+#define		LCM300_METRIC_QUANTILES		2				// tracked quantiles per window; see quantile_set()
+#endif
+#define		LCM300_METRIC_EWMA_TAU_MS	10000			// default EWMA time constant
+
+static_assert (4 == Systronix_LCM300::TELEM_FAN_SPEED, "metrics are the first five telemetry fields");
+
+
+class Systronix_LCM300_metrics
+	{
+	public:
+		enum {VOUT, IOUT, POUT, TEMP_2, FAN_SPEED, METRICS};	// same order as the TELEM_ indexes
+		enum {SECOND, MINUTE, HOUR};						// window indexes
+
+		struct summary_t									// one window of one metric
+			{
+			uint32_t	start_ms;							// millis() when the window began
+			uint32_t	count;								// samples
+			float		mean;
+			float		m2;									// sum of squared differences from the mean; see variance()
+			float		min;
+			float		max;
+			uint32_t	min_ms;								// millis() of the min and max samples
+			uint32_t	max_ms;
+			float		quantile[LCM300_METRIC_QUANTILES];	// estimates at quantile_get() probabilities
+			};
+
+		static float	variance (const summary_t& s);		// sample variance; 0 with fewer than 2 samples
+		static float	stddev (const summary_t& s);
+		static void		merge (summary_t& into, const summary_t& from);
+
+	protected:
+		struct p2_t											// P-square markers of one quantile
+			{
+			float		q[5];								// heights
+			int32_t		n[5];								// positions, 0 based
+			};
+
+		struct window_t
+			{
+			summary_t	current;
+			summary_t	last;								// the most recent complete window; count 0 until there is one
+			p2_t		p2[LCM300_METRIC_QUANTILES];
+			};
+
+		struct metric_t
+			{
+			window_t	window[LCM300_METRIC_WINDOWS];
+			float		ewma;
+			uint32_t	ewma_ms;							// millis() of the sample last folded in
+			bool		ewma_valid;
+			};
+
+		Systronix_LCM300*	_dev = NULL;
+		metric_t	_metric[METRICS];
+		uint32_t	_read_ms[METRICS] = {};				// telemetry.read_ms[] as of the last update()
+		float		_p[LCM300_METRIC_QUANTILES] = {0.5f, 0.95f};
+		uint32_t	_tau_ms = LCM300_METRIC_EWMA_TAU_MS;
+
+		static const uint32_t	_window_ms[LCM300_METRIC_WINDOWS];
+
+		void		roll_metric (metric_t& mt, uint32_t ms);
+		void		window_start (window_t& w, uint32_t start_ms);
+		void		p2_add (p2_t& p2, float p, uint32_t count, float value);
+		float		p2_get (const p2_t& p2, float p, uint32_t count);
+
+	public:
+		uint32_t	sample_count = 0;						// samples taken, all metrics
+
+		void		begin (Systronix_LCM300& dev);			// start all windows now, empty
+		void		reset (void);
+		uint8_t		update (void);							// samples new snapshot values; returns how many
+		void		sample (uint8_t metric, float value, uint32_t ms);	// O(1)
+		void		roll (uint32_t ms);						// close windows that have ended; update() does this
+
+		const summary_t&	current (uint8_t metric, uint8_t window);	// window in progress, quantiles up to date
+		const summary_t&	last (uint8_t metric, uint8_t window);		// most recent complete window
+		float		ewma (uint8_t metric) {return _metric[metric].ewma;}
+
+		void		ewma_set (uint32_t tau_ms);				// EWMA time constant
+		void		quantile_set (uint8_t index, float p);	// track p (0 - 1) in quantile[index]; resets
+		float		quantile_get (uint8_t index) {return _p[index];}
+		static uint32_t	window_ms (uint8_t window) {return _window_ms[window];}
+	};
+
+#endif /* SYSTRONIX_LCM300_METRICS_h */
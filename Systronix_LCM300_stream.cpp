@@ -0,0 +1,238 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_stream.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.3	2026Oct16 begin() empties the ring with a discard mark; read() is the only writer of the tail
+	v0.2	2026Oct16 decode() by cmd[].format
+	v0.1	2026Oct16 start; streams raw READ_VOUT / READ_IOUT etc into a ring buffer
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_stream.h>
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+/*!
+	@brief	Start streaming the commands in mask (CMD_MASK(READ_VOUT_CMD) | CMD_MASK(READ_IOUT_CMD) for example)
+			from dev, round-robin.  A read starts every period_us, or with period_us 0 as soon as the supply's
+			communication interval allows.  Empties the ring and zeroes the counters.
+	@return	SUCCESS, FAIL when mask is empty or has block (ascii, READ_EOUT) commands, ABSENT when the supply
+			doesn't exist
+*/
+
+uint8_t Systronix_LCM300_stream::begin (Systronix_LCM300& dev, uint32_t mask, uint32_t period_us)
+	{
+	mask &= CMD_MASK(CMD_ARRAY_SIZE) - 1;
+	if (0 == mask)
+		return FAIL;
+
+	for (int cmd_idx=0; cmd_idx<CMD_ARRAY_SIZE; cmd_idx++)
+		{
+		if ((mask & CMD_MASK(cmd_idx)) && (LINEAR < dev.cmd[cmd_idx].count))
+			return FAIL;								// only byte and word commands fit in a sample
+		}
+
+	if (!dev.error.exists)
+		return ABSENT;
+
+	_dev = &dev;
+	_mask = mask;
+	_period_us = period_us;
+	_due_us = micros();
+	_cmd_idx = -1;
+	_busy = false;
+	_gap = false;
+
+	__atomic_store_n (&_flush, _head, __ATOMIC_RELEASE);	// empty; read() moves the tail up to here
+	sample_count = overrun_count = fail_count = late_count = 0;
+	rate = 0;
+	_window_us = _due_us;
+	_window_count = 0;
+
+	_running = true;
+	return SUCCESS;
+	}
+
+
+//---------------------------< S T O P >----------------------------------------------------------------------
+//
+// No new reads; the samples already in the ring stay there for read().
+//
+
+void Systronix_LCM300_stream::stop (void)
+	{
+	_running = false;
+	}
+
+
+bool Systronix_LCM300_stream::running (void)
+	{
+	return _running || _busy;
+	}
+
+
+//---------------------------< T I C K >----------------------------------------------------------------------
+/*!
+	@brief	The producer.  Call often, from loop() or a timer.  Advances the read in progress and stores its
+			sample; when the supply is free and the next read is due, starts the next command.  Never blocks.
+	@return	LCM300_PENDING while streaming, SUCCESS once stopped and the last read is finished
+*/
+
+uint8_t Systronix_LCM300_stream::tick (void)
+	{
+	uint32_t	now;
+	uint8_t		ret_val;
+
+	if (_busy)
+		{
+		ret_val = _dev->command_poll();
+		if (LCM300_PENDING == ret_val)
+			return LCM300_PENDING;
+
+		_busy = false;
+		if (SUCCESS == ret_val)
+			push();
+		else
+			fail_count++;
+		}
+
+	if (!_running)
+		return SUCCESS;
+
+	if (_dev->interval_remaining() || _dev->command_busy())
+		return LCM300_PENDING;
+
+	now = micros();
+	if (_period_us)
+		{
+		if ((int32_t)(now - _due_us) < 0)
+			return LCM300_PENDING;					// not yet
+
+		if ((now - _due_us) >= _period_us)			// missed at least one whole period; start over from now
+			{
+			late_count++;
+			_due_us = now;
+			}
+		_due_us += _period_us;
+		}
+
+	do												// next streamed command after the last one, round-robin
+		_cmd_idx = (_cmd_idx + 1) % CMD_ARRAY_SIZE;
+	while (!(_mask & CMD_MASK(_cmd_idx)));
+
+	if (SUCCESS == _dev->command_start_into (_cmd_idx, &_rx))
+		{
+		_dev->command_poll();						// interval has elapsed so this puts the command byte on the bus
+		_busy = true;
+		}
+	return LCM300_PENDING;
+	}
+
+
+//---------------------------< P U S H >----------------------------------------------------------------------
+//
+// Store the completed read as a sample, or count it as an overrun when the ring is full.  Only the producer
+// writes _head; the release store publishes the sample before the consumer can see the new head.
+//
+
+void Systronix_LCM300_stream::push (void)
+	{
+	uint32_t			head = _head;
+	uint32_t			tail = __atomic_load_n (&_tail, __ATOMIC_ACQUIRE);
+	uint32_t			now = _rx.us;
+	lcm300_sample_t*	sample;
+
+	if (LCM300_STREAM_RING <= (head - tail))
+		{
+		overrun_count++;
+		_gap = true;
+		}
+	else
+		{
+		sample = &_ring[head & (LCM300_STREAM_RING - 1)];
+		sample->us = now;
+		sample->raw = (A_BYTE == _dev->cmd[_rx.cmd_idx].count) ? _rx.data.as_byte : _rx.data.as_word;
+		sample->cmd_idx = (uint8_t)_rx.cmd_idx;
+		sample->flags = _gap ? LCM300_STREAM_GAP : 0;
+		_gap = false;
+		__atomic_store_n (&_head, head + 1, __ATOMIC_RELEASE);
+		sample_count++;
+		}
+
+	_window_count++;								// rate counts reads, stored or not
+	if ((now - _window_us) >= LCM300_STREAM_RATE_US)
+		{
+		rate = (float)_window_count * 1000000 / (now - _window_us);
+		_window_us = now;
+		_window_count = 0;
+		}
+	}
+
+
+//---------------------------< T A I L _ G E T >--------------------------------------------------------------
+//
+// The consumer's tail, skipped past any samples begin() has discarded.  _tail itself is left for read() to
+// store, so push() keeps seeing the old tail (and doesn't reuse slots that a read() in progress may still be
+// copying) until the consumer has caught up.
+//
+
+uint32_t Systronix_LCM300_stream::tail_get (void)
+	{
+	uint32_t	tail = _tail;
+	uint32_t	flush = __atomic_load_n (&_flush, __ATOMIC_ACQUIRE);
+
+	if (0 < (int32_t)(flush - tail))
+		tail = flush;
+	return tail;
+	}
+
+
+//---------------------------< A V A I L A B L E >------------------------------------------------------------
+
+uint32_t Systronix_LCM300_stream::available (void)
+	{
+	uint32_t	tail = tail_get();
+
+	return __atomic_load_n (&_head, __ATOMIC_ACQUIRE) - tail;
+	}
+
+
+//---------------------------< R E A D >----------------------------------------------------------------------
+/*!
+	@brief	The consumer.  Move up to max of the oldest samples out of the ring into dest.  Only the consumer
+			writes _tail; the release store hands the slots back to the producer after they have been copied.
+	@return	number of samples moved
+*/
+
+size_t Systronix_LCM300_stream::read (lcm300_sample_t* dest, size_t max)
+	{
+	uint32_t	tail = tail_get();
+	uint32_t	count = __atomic_load_n (&_head, __ATOMIC_ACQUIRE) - tail;
+	uint32_t	i;
+
+	if (count > max)
+		count = max;
+
+	for (i=0; i<count; i++)
+		dest[i] = _ring[(tail + i) & (LCM300_STREAM_RING - 1)];
+
+	__atomic_store_n (&_tail, tail + count, __ATOMIC_RELEASE);
+	return count;
+	}
+
+
+//---------------------------< D E C O D E >------------------------------------------------------------------
+//
+// Samples to engineering units with the supply's VOUT_MODE exponent; see Systronix_LCM300::decode().
+//
+
+void Systronix_LCM300_stream::decode (const lcm300_sample_t* sample, float* value, size_t count)
+	{
+	for (size_t i=0; i<count; i++)
+		value[i] = _dev->decode (sample[i].cmd_idx, sample[i].raw);
+	}
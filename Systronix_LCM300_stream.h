@@ -0,0 +1,110 @@
+#ifndef SYSTRONIX_LCM300_STREAM_h
+#define SYSTRONIX_LCM300_STREAM_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_stream.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.3	2026Oct16 begin() empties the ring with a discard mark; read() is the only writer of the tail
+	v0.1	2026Oct16 start; streams raw READ_VOUT / READ_IOUT etc into a ring buffer
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	For transient work: read a small set of word or byte commands from one supply over and over, as
+	fast as its communication interval allows or at a set period, and keep each response as a compact
+	raw sample (micros() timestamp, raw word, cmd[] index) in a ring buffer.  Nothing is decoded or
+	printed while streaming; the consumer drains the ring with read() and decodes in bulk, e.g. with
+	decode() or Systronix_LCM300::decode_linear11() / decode_linear16().
+
+	The ring is single-producer / single-consumer and lock-free: tick() is the only writer of the
+	head, read() the only writer of the tail, so tick() can run in loop() while read() runs from an
+	IntervalTimer or another task (or the other way round) without disabling interrupts.  begin() is
+	on the producer side too: it empties the ring by moving a discard mark up to the head, and the
+	next read() or available() skips the tail past it, so begin() can be called while the consumer
+	is running.  When the
+	consumer falls behind, new samples are dropped and counted in overrun_count, and the next sample
+	that does go in carries LCM300_STREAM_GAP.
+
+	Rules:
+	- the supply must have been setup(), begin()'d and init()'d
+	- while streaming, don't read the supply any other way, and don't also register it with a
+	  Systronix_LCM300_bus; the telemetry snapshot stays current for the streamed commands
+	- the LCM300 wants LCM300_CMD_INTERVAL_US (50 ms) between transactions, so one supply streams at
+	  most about 20 samples per second in total at the default Systronix_LCM300::interval_set()
+***************************************************************************************************/
+
+
+#include <Systronix_LCM300.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#ifndef		LCM300_STREAM_RING
+#define		LCM300_STREAM_RING		256				// samples; must be a power of 2
+#endif
+
+#define		LCM300_STREAM_GAP		0x01			// lcm300_sample_t.flags: samples were dropped just before this one
+#define		LCM300_STREAM_RATE_US	1000000			// rate is measured over windows this long
+
+static_assert (0 == (LCM300_STREAM_RING & (LCM300_STREAM_RING - 1)), "LCM300_STREAM_RING must be a power of 2");
+
+struct lcm300_sample_t
+	{
+	uint32_t	us;										// micros() when the read completed
+	uint16_t	raw;									// response as read: linear-11, linear-16, or a status byte
+	uint8_t		cmd_idx;								// cmd[] index
+	uint8_t		flags;									// LCM300_STREAM_GAP
+	};
+
+
+class Systronix_LCM300_stream
+	{
+	protected:
+		Systronix_LCM300*	_dev = NULL;
+		uint32_t	_mask = 0;								// CMD_MASK() bits of the streamed commands
+		uint32_t	_period_us = 0;							// time between the starts of successive reads; 0 = no faster than the supply allows
+		uint32_t	_due_us = 0;							// micros() when the next read is due
+		int			_cmd_idx = -1;							// cmd[] index of the most recent read
+		bool		_running = false;
+		bool		_busy = false;							// a read is in progress
+		bool		_gap = false;							// a sample was dropped since the last one stored
+
+		Systronix_LCM300::response_t	_rx;				// the read in progress lands here
+
+		lcm300_sample_t	_ring[LCM300_STREAM_RING];
+		uint32_t	_head = 0;								// samples ever stored; written only by tick()
+		uint32_t	_tail = 0;								// samples ever read; written only by read()
+		uint32_t	_flush = 0;								// samples before this are discarded; written only by begin()
+
+		uint32_t	_window_us = 0;							// start of the current rate window
+		uint32_t	_window_count = 0;						// samples in it
+
+		void		push (void);
+		uint32_t	tail_get (void);
+
+	public:
+		uint32_t	sample_count = 0;						// samples stored in the ring
+		uint32_t	overrun_count = 0;						// samples dropped because the ring was full
+		uint32_t	fail_count = 0;							// reads that failed (NAK, timeout, PEC, ...)
+		uint32_t	late_count = 0;							// reads that started more than a period late
+		float		rate = 0;								// measured samples per second, updated every LCM300_STREAM_RATE_US
+
+		uint8_t		begin (Systronix_LCM300& dev, uint32_t mask, uint32_t period_us=0);	// SUCCESS, FAIL, or ABSENT
+		void		stop (void);							// finishes the read in progress on the next tick()
+		bool		running (void);
+
+		uint8_t		tick (void);							// producer; call often.  LCM300_PENDING while streaming else SUCCESS
+
+		uint32_t	available (void);						// consumer: samples waiting
+		size_t		read (lcm300_sample_t* dest, size_t max);	// consumer: move up to max samples out of the ring
+		void		decode (const lcm300_sample_t* sample, float* value, size_t count);	// volts, amps, watts ...; status as is
+	};
+
+#endif /* SYSTRONIX_LCM300_STREAM_h */
@@ -0,0 +1,345 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_trace.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 probe() recorded as a write of nothing
+	v0.1	2026Oct16 start; records every bus transaction of a transport to a compact trace
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_trace.h>
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+//
+// Record from now on, each record to sink.  Write header() first.  The first record's dt is from now.
+//
+
+void Systronix_LCM300_recorder::begin (void (*sink)(const uint8_t* record, size_t count))
+	{
+	_sink = sink;
+	_last_us = micros();
+	_pending = false;
+	enable (true);
+	}
+
+
+//---------------------------< H E A D E R >------------------------------------------------------------------
+
+size_t Systronix_LCM300_recorder::header (uint8_t* buf)
+	{
+	memcpy (buf, "LCMTRC", 6);
+	buf[6] = LCM300_TRACE_VERSION;
+	buf[7] = 0;
+	return LCM300_TRACE_HEADER_SIZE;
+	}
+
+
+//---------------------------< E N C O D E >------------------------------------------------------------------
+
+static uint8_t* put_varint (uint8_t* p, uint32_t n)
+	{
+	while (0x7F < n)
+		{
+		*p++ = 0x80 | (n & 0x7F);
+		n >>= 7;
+		}
+	*p++ = (uint8_t)n;
+	return p;
+	}
+
+
+size_t Systronix_LCM300_recorder::encode (uint8_t* buf, const lcm300_trace_record_t& rec)
+	{
+	uint8_t*	p = buf;
+	uint8_t		count = (LCM300_TRACE_DATA_MAX < rec.count) ? LCM300_TRACE_DATA_MAX : rec.count;
+
+	*p++ = (uint8_t)((rec.kind & 0x07) | (rec.unfinished ? LCM300_TRACE_UNFINISHED : 0) | (rec.status << 4));
+	*p++ = rec.address;
+	p = put_varint (p, rec.dt_us);
+	p = put_varint (p, rec.duration_us);
+	if (LCM300_TRACE_RESET == rec.kind)
+		return p - buf;
+
+	if ((LCM300_TRACE_READ == rec.kind) || (LCM300_TRACE_READ_NOSTOP == rec.kind))
+		*p++ = rec.requested;
+	*p++ = count;
+	memcpy (p, rec.data, count);
+	return (p + count) - buf;
+	}
+
+
+//---------------------------< D E C O D E >------------------------------------------------------------------
+//
+// One record from buf[0..count).  Returns the bytes it took, or 0 when buf ends partway through a record or what
+// is there is not a record (unknown kind, varint or count too long).
+//
+
+static const uint8_t* get_varint (const uint8_t* p, const uint8_t* end, uint32_t& n)
+	{
+	int		shift = 0;
+
+	n = 0;
+	do
+		{
+		if ((p >= end) || (28 < shift))
+			return NULL;
+		n |= (uint32_t)(*p & 0x7F) << shift;
+		shift += 7;
+		}
+	while (*p++ & 0x80);
+	return p;
+	}
+
+
+size_t Systronix_LCM300_recorder::decode (const uint8_t* buf, size_t count, lcm300_trace_record_t& rec)
+	{
+	const uint8_t*	p = buf;
+	const uint8_t*	end = buf + count;
+
+	if (2 > count)
+		return 0;
+	rec.kind = *p & 0x07;
+	rec.unfinished = (0 != (*p & LCM300_TRACE_UNFINISHED));
+	rec.status = *p++ >> 4;
+	rec.address = *p++;
+	if ((LCM300_TRACE_WRITE > rec.kind) || (LCM300_TRACE_RESET < rec.kind))
+		return 0;
+
+	p = get_varint (p, end, rec.dt_us);
+	if (p)
+		p = get_varint (p, end, rec.duration_us);
+	if (!p)
+		return 0;
+
+	rec.requested = rec.count = 0;
+	if (LCM300_TRACE_RESET == rec.kind)
+		return p - buf;
+
+	if ((LCM300_TRACE_READ == rec.kind) || (LCM300_TRACE_READ_NOSTOP == rec.kind))
+		{
+		if (p >= end)
+			return 0;
+		rec.requested = *p++;
+		}
+	if (p >= end)
+		return 0;
+	rec.count = *p++;
+	if ((LCM300_TRACE_DATA_MAX < rec.count) || (rec.count > end - p))
+		return 0;
+	memcpy (rec.data, p, rec.count);
+	return (p + rec.count) - buf;
+	}
+
+
+//---------------------------< E M I T >----------------------------------------------------------------------
+//
+// _rec, which started at start_us, to the sink
+//
+
+void Systronix_LCM300_recorder::emit (uint32_t start_us)
+	{
+	uint8_t		buf[LCM300_TRACE_RECORD_MAX];
+	size_t		count;
+
+	_pending = false;
+	_rec.dt_us = start_us - _last_us;
+	_last_us = start_us;
+	count = encode (buf, _rec);
+	_sink (buf, count);
+	record_count++;
+	byte_count += count;
+	}
+
+
+//---------------------------< S E T T L E >------------------------------------------------------------------
+//
+// Before anything else goes on the bus, the pending transfer is recorded: normally if it has finished (nobody
+// asked), else as unfinished with the status it has now.
+//
+
+void Systronix_LCM300_recorder::settle (void)
+	{
+	if (!_pending || done())
+		return;
+
+	_rec.unfinished = true;
+	_rec.status = _inner.status();
+	_rec.duration_us = micros() - _start_us;
+	emit (_start_us);
+	}
+
+
+//---------------------------< T R A N S P O R T >------------------------------------------------------------
+//
+// Everything goes to _inner.  Starts and blocking writes note what was asked for; the record is finished and
+// emitted when the transfer is done, with the bytes received, which are then read from here.
+//
+
+void Systronix_LCM300_recorder::begin (i2c_pins pins)
+	{
+	_inner.begin (pins);
+	}
+
+
+uint8_t Systronix_LCM300_recorder::write (uint8_t address, const uint8_t* data, size_t count)
+	{
+	uint32_t	start;
+	uint8_t		ret_val;
+
+	settle ();
+	start = micros();
+	ret_val = _inner.write (address, data, count);
+	write_record (start, address, data, count);
+	return ret_val;
+	}
+
+
+uint8_t Systronix_LCM300_recorder::probe (uint8_t address)	// _inner's, with its short timeout; a write of nothing
+	{
+	uint32_t	start;
+	uint8_t		ret_val;
+
+	settle ();
+	start = micros();
+	ret_val = _inner.probe (address);
+	write_record (start, address, NULL, 0);
+	return ret_val;
+	}
+
+
+void Systronix_LCM300_recorder::write_record (uint32_t start_us, uint8_t address, const uint8_t* data, size_t count)
+	{
+	if (!_enabled)
+		return;
+
+	_rec.kind = LCM300_TRACE_WRITE;
+	_rec.unfinished = false;
+	_rec.status = _inner.status();
+	_rec.address = address;
+	_rec.duration_us = 0;
+	_rec.requested = 0;
+	_rec.count = (LCM300_TRACE_DATA_MAX < count) ? LCM300_TRACE_DATA_MAX : count;
+	if (_rec.count)
+		memcpy (_rec.data, data, _rec.count);
+	emit (start_us);
+	}
+
+
+bool Systronix_LCM300_recorder::write_start (uint8_t address, const uint8_t* data, size_t count, bool stop)
+	{
+	settle ();
+	_rx_count = _rx_index = 0;
+	if (!_inner.write_start (address, data, count, stop))
+		return false;
+	if (_enabled)
+		{
+		_start_us = micros();
+		_rec.kind = stop ? LCM300_TRACE_WRITE_STOP : LCM300_TRACE_WRITE_NOSTOP;
+		_rec.unfinished = false;
+		_rec.address = address;
+		_rec.requested = 0;
+		_rec.count = (LCM300_TRACE_DATA_MAX < count) ? LCM300_TRACE_DATA_MAX : count;
+		memcpy (_rec.data, data, _rec.count);
+		_pending = true;
+		}
+	return true;
+	}
+
+
+void Systronix_LCM300_recorder::read_start (uint8_t address, size_t count, bool stop)
+	{
+	settle ();
+	_inner.read_start (address, count, stop);
+	_rx_count = _rx_index = 0;
+	_pending = _enabled;
+	if (_enabled)
+		{
+		_start_us = micros();
+		_rec.kind = stop ? LCM300_TRACE_READ : LCM300_TRACE_READ_NOSTOP;
+		_rec.unfinished = false;
+		_rec.address = address;
+		_rec.requested = (255 < count) ? 255 : count;
+		_rec.count = 0;
+		}
+	}
+
+
+bool Systronix_LCM300_recorder::done (void)
+	{
+	if (!_inner.done())
+		return false;
+
+	if (_pending)
+		{
+		_rec.status = _inner.status();
+		_rec.duration_us = micros() - _start_us;
+		if ((LCM300_TRACE_READ == _rec.kind) || (LCM300_TRACE_READ_NOSTOP == _rec.kind))
+			{
+			_rx_count = _inner.read (_rx, sizeof(_rx));
+			_rx_index = 0;
+			_rec.count = _rx_count;
+			memcpy (_rec.data, _rx, _rx_count);
+			}
+		emit (_start_us);
+		}
+	return true;
+	}
+
+
+uint8_t Systronix_LCM300_recorder::status (void)
+	{
+	return _inner.status();
+	}
+
+
+size_t Systronix_LCM300_recorder::available (void)
+	{
+	return (_rx_count - _rx_index) + _inner.available();	// _inner has none once a recorded read is done
+	}
+
+
+size_t Systronix_LCM300_recorder::read (uint8_t* dest, size_t count)
+	{
+	size_t	taken = 0;
+
+	while ((taken < count) && (_rx_index < _rx_count))
+		{
+		if (dest)
+			dest[taken] = _rx[_rx_index];
+		_rx_index++;
+		taken++;
+		}
+	return taken + _inner.read (dest ? dest + taken : NULL, count - taken);
+	}
+
+
+void Systronix_LCM300_recorder::reset_bus (void)
+	{
+	uint32_t	start;
+
+	settle ();
+	start = micros();
+	_inner.reset_bus();
+	if (_enabled)
+		{
+		_rec.kind = LCM300_TRACE_RESET;
+		_rec.unfinished = false;
+		_rec.status = 0;
+		_rec.address = 0;
+		_rec.duration_us = 0;
+		_rec.requested = _rec.count = 0;
+		emit (start);
+		}
+	}
+
+
+uint32_t Systronix_LCM300_recorder::reset_bus_count (void)
+	{
+	return _inner.reset_bus_count();
+	}
@@ -0,0 +1,129 @@
+#ifndef SYSTRONIX_LCM300_TRACE_h
+#define SYSTRONIX_LCM300_TRACE_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_trace.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 probe() recorded as a write of nothing
+	v0.1	2026Oct16 start; records every bus transaction of a transport to a compact trace
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Captures the bus conversation itself, for regression tests and benchmarks against real LCM300
+	quirks (bogus block lengths, 0xFF padding, EOUT rollovers, NAKs).  Systronix_LCM300_recorder is
+	a Systronix_LCM300_transport that passes everything through to another transport and hands a
+	record of each transaction to a sink function of yours (write it to SD, Serial, a RAM buffer):
+
+		Systronix_LCM300_recorder	recorder (Systronix_LCM300_i2c_t3::shared (Wire1));
+		recorder.begin (sink);					// sink (const uint8_t* record, size_t count)
+		supply.setup (0x58, recorder, (char*)"Wire1");
+
+	Records are built and passed to the sink from whatever calls the driver (command_poll(), etc),
+	never from an interrupt.  A trace is the header followed by records; multi-byte fields are
+	little endian, varints 7 bits per byte, least significant first, msb set on all but the last:
+
+	header		'L' 'C' 'M' 'T' 'R' 'C' LCM300_TRACE_VERSION 0
+
+	record		kind | status << 4	LCM300_TRACE_..., LCM300_TRACE_UNFINISHED when the transfer was never done()
+									before the next one started (the driver gave up on it); the i2c_status
+									it ended with, or had when abandoned
+				address				7-bit
+				dt					varint; micros() from the start of the previous record to this one
+				duration			varint; micros() from start to done() (0 for write(), which blocks)
+				requested			reads only: bytes asked for
+				count				bytes that follow: written, or received
+				data
+
+	reset		LCM300_TRACE_RESET, 0, dt, 0: reset_bus()
+
+	probe() is recorded as a write() with no data.
+
+	A transfer in flight when recording stops is lost unless flush() is called first.
+
+	Data beyond LCM300_TRACE_DATA_MAX bytes is not kept; no LCM300 transaction comes near it.  On the
+	host, extras/host/lcm300_replay feeds a trace back through Systronix_LCM300 at full speed.
+***************************************************************************************************/
+
+
+#include <Systronix_LCM300_transport.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#define		LCM300_TRACE_VERSION		1
+#define		LCM300_TRACE_HEADER_SIZE	8
+#define		LCM300_TRACE_DATA_MAX		32
+#define		LCM300_TRACE_RECORD_MAX		(2 + 5 + 5 + 2 + LCM300_TRACE_DATA_MAX)	// most bytes in one record
+
+enum {LCM300_TRACE_WRITE = 1, LCM300_TRACE_WRITE_NOSTOP, LCM300_TRACE_WRITE_STOP, LCM300_TRACE_READ,	// record kinds:
+	LCM300_TRACE_READ_NOSTOP, LCM300_TRACE_RESET};		// write(), write_start() and read_start() with stop or not, reset_bus()
+#define		LCM300_TRACE_UNFINISHED		0x08			// or'd with the kind
+
+struct lcm300_trace_record_t
+	{
+	uint8_t		kind;									// LCM300_TRACE_...
+	bool		unfinished;								// never done(); see LCM300_TRACE_UNFINISHED
+	uint8_t		status;									// i2c_status
+	uint8_t		address;
+	uint32_t	dt_us;									// since the start of the previous record
+	uint32_t	duration_us;
+	uint8_t		requested;								// reads: bytes asked for
+	uint8_t		count;									// bytes in data[]
+	uint8_t		data[LCM300_TRACE_DATA_MAX];
+	};
+
+
+class Systronix_LCM300_recorder : public Systronix_LCM300_transport
+	{
+	protected:
+		Systronix_LCM300_transport&	_inner;
+		void		(*_sink)(const uint8_t* record, size_t count) = NULL;
+		bool		_enabled = false;
+		bool		_pending = false;						// a write_start() or read_start() not yet done()
+		uint32_t	_last_us = 0;							// start of the previous record
+		uint32_t	_start_us = 0;							// start of the pending transfer
+		lcm300_trace_record_t	_rec;						// the pending transfer
+		uint8_t		_rx[LCM300_TRACE_DATA_MAX];			// received bytes, taken from _inner when the read is done
+		uint8_t		_rx_count = 0;
+		uint8_t		_rx_index = 0;
+
+		void		emit (uint32_t start_us);
+		void		settle (void);							// record the pending transfer, done or not
+		void		write_record (uint32_t start_us, uint8_t address, const uint8_t* data, size_t count);
+
+	public:
+		uint32_t	record_count = 0;
+		uint32_t	byte_count = 0;							// record bytes passed to the sink
+
+					Systronix_LCM300_recorder (Systronix_LCM300_transport& inner) : _inner (inner) {}
+
+		void		begin (void (*sink)(const uint8_t* record, size_t count));	// and start recording
+		void		enable (bool enable) {_enabled = enable && _sink;}
+		void		flush (void) {settle();}				// before stopping: record the transfer in flight
+
+		static size_t	header (uint8_t* buf);				// LCM300_TRACE_HEADER_SIZE bytes
+		static size_t	encode (uint8_t* buf, const lcm300_trace_record_t& rec);	// up to LCM300_TRACE_RECORD_MAX bytes
+		static size_t	decode (const uint8_t* buf, size_t count, lcm300_trace_record_t& rec);	// 0: incomplete or damaged
+
+		void		begin (i2c_pins pins);
+		uint8_t		write (uint8_t address, const uint8_t* data, size_t count);
+		bool		write_start (uint8_t address, const uint8_t* data, size_t count, bool stop);
+		void		read_start (uint8_t address, size_t count, bool stop);
+		bool		done (void);
+		uint8_t		status (void);
+		size_t		available (void);
+		size_t		read (uint8_t* dest, size_t count);
+		void		reset_bus (void);
+		uint32_t	reset_bus_count (void);
+		uint8_t		probe (uint8_t address);
+	};
+
+#endif /* SYSTRONIX_LCM300_TRACE_h */
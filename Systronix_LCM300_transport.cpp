@@ -0,0 +1,146 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_transport.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 probe(): address-only write with a short timeout
+	v0.1	2026Oct16 start; the I2C master operations the LCM300 driver uses, and an i2c_t3 backend
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_transport.h>
+
+
+//---------------------------< S H A R E D >------------------------------------------------------------------
+//
+// The backend for wire, in DMA mode; every caller with the same wire gets the same one.  There are only as many
+// i2c_t3 buses as slots, so a slot is always free for a new one.
+//
+
+Systronix_LCM300_i2c_t3& Systronix_LCM300_i2c_t3::shared (i2c_t3& wire)
+	{
+	static Systronix_LCM300_i2c_t3	backend[LCM300_TRANSPORT_BUSES];
+	uint8_t	i;
+
+	for (i=0; i<LCM300_TRANSPORT_BUSES; i++)
+		{
+		if (!backend[i]._wire)								// first free slot; wire is new
+			backend[i]._wire = &wire;
+		if (&wire == backend[i]._wire)
+			return backend[i];
+		}
+	return backend[0];										// can't get here
+	}
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+
+void Systronix_LCM300_i2c_t3::begin (i2c_pins pins)
+	{
+	_wire->begin (I2C_MASTER, 0x00, pins, I2C_PULLUP_EXT, I2C_RATE_100);	// join I2C as master
+	_wire->setOpMode (_mode);								// i2c_t3 falls back to ISR when no DMA channel is free
+	_wire->setDefaultTimeout (LCM300_TRANSPORT_TIMEOUT_US);
+	}
+
+
+//---------------------------< W R I T E >--------------------------------------------------------------------
+//
+// Blocking write with a stop.  Returns as endTransmission() does: 0 success, 1 data too long for the buffer,
+// 2 address NAK, 3 data NAK, 4 other error.
+//
+
+uint8_t Systronix_LCM300_i2c_t3::write (uint8_t address, const uint8_t* data, size_t count)
+	{
+	_wire->beginTransmission (address);
+	if (count != _wire->write (data, count))
+		return 1;
+	return _wire->endTransmission ();
+	}
+
+
+//---------------------------< P R O B E >--------------------------------------------------------------------
+//
+// The address and a stop, with LCM300_TRANSPORT_PROBE_US to finish instead of the 200ms default, so an empty
+// slot or a held bus costs next to nothing.  0 when the address was acknowledged, else as endTransmission().
+//
+
+uint8_t Systronix_LCM300_i2c_t3::probe (uint8_t address)
+	{
+	_wire->beginTransmission (address);
+	return _wire->endTransmission (I2C_STOP, LCM300_TRANSPORT_PROBE_US);
+	}
+
+
+//---------------------------< W R I T E _ S T A R T >--------------------------------------------------------
+
+bool Systronix_LCM300_i2c_t3::write_start (uint8_t address, const uint8_t* data, size_t count, bool stop)
+	{
+	_wire->beginTransmission (address);
+	if (count != _wire->write (data, count))
+		return false;
+	_wire->sendTransmission (stop ? I2C_STOP : I2C_NOSTOP);
+	return true;
+	}
+
+
+//---------------------------< R E A D _ S T A R T >----------------------------------------------------------
+
+void Systronix_LCM300_i2c_t3::read_start (uint8_t address, size_t count, bool stop)
+	{
+	_wire->sendRequest (address, count, stop ? I2C_STOP : I2C_NOSTOP);
+	}
+
+
+//---------------------------< D O N E ,   S T A T U S >------------------------------------------------------
+
+bool Systronix_LCM300_i2c_t3::done (void)
+	{
+	return _wire->done();
+	}
+
+
+uint8_t Systronix_LCM300_i2c_t3::status (void)
+	{
+	return _wire->status();
+	}
+
+
+//---------------------------< A V A I L A B L E ,   R E A D >------------------------------------------------
+
+size_t Systronix_LCM300_i2c_t3::available (void)
+	{
+	return _wire->available();
+	}
+
+
+size_t Systronix_LCM300_i2c_t3::read (uint8_t* dest, size_t count)
+	{
+	size_t	i;
+
+	for (i=0; (i<count) && _wire->available(); i++)
+		{
+		if (dest)
+			dest[i] = _wire->readByte();
+		else
+			_wire->readByte();
+		}
+	return i;
+	}
+
+
+//---------------------------< R E S E T _ B U S >------------------------------------------------------------
+
+void Systronix_LCM300_i2c_t3::reset_bus (void)
+	{
+	_wire->resetBus();
+	}
+
+
+uint32_t Systronix_LCM300_i2c_t3::reset_bus_count (void)
+	{
+	return _wire->resetBusCountRead();
+	}
@@ -0,0 +1,106 @@
+#ifndef SYSTRONIX_LCM300_TRANSPORT_h
+#define SYSTRONIX_LCM300_TRANSPORT_h
+
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_transport.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 probe(): address-only write with a short timeout
+	v0.1	2026Oct16 start; the I2C master operations the LCM300 driver uses, and an i2c_t3 backend
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Systronix_LCM300 talks to its Wire net only through a Systronix_LCM300_transport, which it holds
+	by reference: every supply on one net shares one transport object, and so one copy of the
+	driver state.  A transport does the few master operations the driver needs:
+
+	write()			a whole write with a stop; blocks.  PMBus send byte, write byte, write word.
+	write_start()	start a write; with stop false the bus is held for the repeated start that follows
+	read_start()	start a read of count bytes
+	done()			the started write or read has finished (or failed); never blocks
+	status()		i2c_status of the last write or read: I2C_WAITING when it succeeded
+	available(),
+	read()			bytes received by the last read
+	probe()			address only, nothing written: is anything there?  Blocks for no more than
+					LCM300_TRANSPORT_PROBE_US, not the full timeout.  By default write() of nothing.
+
+	Systronix_LCM300_i2c_t3 is the Teensy backend.  write_start() and read_start() are i2c_t3
+	sendTransmission() / sendRequest(), which return at once and leave the transfer to the I2C
+	interrupt, or in I2C_OP_MODE_DMA (the default) to DMA, so the CPU is free while bytes move.
+	done() reads the state the ISR keeps.  i2c_t3's own onTransmitDone() / onReqFromDone() callbacks
+	are one per bus with no argument to say which transfer finished, so the driver polls done()
+	from command_poll(), which it does anyway to pace the 50 ms communication interval.
+
+	Systronix_LCM300_i2c_t3::shared (Wire1) is the one backend for Wire1; setup (base, Wire1, name)
+	uses it, so sketches written for the i2c_t3& setup() work as before.  Host builds have their own
+	backend: see extras/host/Systronix_LCM300_host_transport.h.
+***************************************************************************************************/
+
+
+#include <Arduino.h>
+#include <i2c_t3.h>
+
+
+//---------------------------< D E F I N E S >----------------------------------------------------------------
+
+#define		LCM300_TRANSPORT_BUSES		4				// i2c_t3 buses: Wire - Wire3 on the Teensy 3.6
+#define		LCM300_TRANSPORT_TIMEOUT_US	200000			// i2c_t3 default timeout: 200ms
+#define		LCM300_TRANSPORT_PROBE_US	2000			// probe() timeout; an address byte takes 90us at 100kHz
+
+
+class Systronix_LCM300_transport
+	{
+	public:
+		virtual				~Systronix_LCM300_transport () {}
+
+		virtual void		begin (i2c_pins pins) = 0;		// join the net as master at 100kHz
+		virtual uint8_t		write (uint8_t address, const uint8_t* data, size_t count) = 0;	// Wire endTransmission() codes: 0 success
+		virtual bool		write_start (uint8_t address, const uint8_t* data, size_t count, bool stop) = 0;	// false: data didn't fit
+		virtual void		read_start (uint8_t address, size_t count, bool stop) = 0;
+		virtual bool		done (void) = 0;
+		virtual uint8_t		status (void) = 0;				// i2c_status
+		virtual size_t		available (void) = 0;
+		virtual size_t		read (uint8_t* dest, size_t count) = 0;	// dest NULL discards
+		virtual void		reset_bus (void) = 0;
+		virtual uint32_t	reset_bus_count (void) = 0;
+		virtual uint8_t		probe (uint8_t address) {return write (address, NULL, 0);}	// write() codes; 0: acknowledged
+	};
+
+
+//---------------------------< S Y S T R O N I X _ L C M 3 0 0 _ I 2 C _ T 3 >----------------------------------
+
+class Systronix_LCM300_i2c_t3 : public Systronix_LCM300_transport
+	{
+	protected:
+		i2c_t3*		_wire;
+		i2c_op_mode	_mode;
+
+					Systronix_LCM300_i2c_t3 (void) : _wire (NULL), _mode (I2C_OP_MODE_DMA) {}	// shared() slots
+
+	public:
+					Systronix_LCM300_i2c_t3 (i2c_t3& wire, i2c_op_mode mode=I2C_OP_MODE_DMA) : _wire (&wire), _mode (mode) {}
+
+		static Systronix_LCM300_i2c_t3&	shared (i2c_t3& wire);	// the one backend for wire, made on first use
+
+		void		begin (i2c_pins pins);
+		uint8_t		write (uint8_t address, const uint8_t* data, size_t count);
+		bool		write_start (uint8_t address, const uint8_t* data, size_t count, bool stop);
+		void		read_start (uint8_t address, size_t count, bool stop);
+		bool		done (void);
+		uint8_t		status (void);
+		size_t		available (void);
+		size_t		read (uint8_t* dest, size_t count);
+		void		reset_bus (void);
+		uint32_t	reset_bus_count (void);
+		uint8_t		probe (uint8_t address);
+		i2c_t3&		wire (void) {return *_wire;}
+	};
+
+#endif /* SYSTRONIX_LCM300_TRANSPORT_h */
@@ -0,0 +1,76 @@
+/** ---------- LCM300Q Binary Telemetry Log ------------------------
+
+Controller is Teensy3
+
+Copyright 2026 Systronix Inc www.systronix.com
+
+Logs raw telemetry from every LCM300 at 0x58-0x5F on Wire1 to Serial as compact binary records instead of
+printf'd floats: about 5 bytes a reading instead of 20 or more, and no rounding.  Capture the serial port
+to a file and convert it on a PC with extras/host/lcm300_log2csv.
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		bus.discover() in place of init() per address; failed reads not logged
+
+--------------------------------**/
+
+#include <Arduino.h>
+#include <Systronix_LCM300_bus.h>	// best version of I2C library is #included by the library. Don't include it here!
+#include <Systronix_LCM300_log.h>
+
+
+Systronix_LCM300		supply[LCM300_BUS_MAX_DEVICES];		// one for each possible address
+Systronix_LCM300_bus	bus;
+Systronix_LCM300_log	lcm_log;
+
+uint8_t		record[LCM300_LOG_RECORD_MAX];
+
+
+//---------------------------< R E A D _ D O N E >------------------------------------------------------------
+//
+// called by bus.tick() as each read completes; failed reads aren't logged
+//
+
+void read_done (Systronix_LCM300* dev, int, uint8_t result)
+	{
+	if (SUCCESS != result)
+		return;										// nothing new in response_last()
+
+	Serial.write (record, lcm_log.response (record, *dev, dev->response_last()));
+	}
+
+
+//---------------------------< S E T U P >--------------------------------------------------------------------
+
+void setup(void)
+	{
+	Serial.begin(115200);     // use max baud rate
+	while((!Serial) && (millis()<10000));    // wait until serial monitor is open or timeout
+
+	Serial.write (record, lcm_log.header (record));
+
+	for (uint8_t i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		supply[i].setup (LCM300_BASE_MIN + i, Wire1, (char*)"Wire1");
+		supply[i].begin(I2C_PINS_29_30);
+		}
+
+	bus.discover (supply, LCM300_BUS_MAX_DEVICES);	// probe every address; identity of all present supplies at once
+
+	bus.callback_set (read_done);
+	bus.queue (VOUT_MODE_CMD);						// the decoder needs each supply's Vout exponent first
+	bus.run ();
+	}
+
+
+/* ========== LOOP ========== */
+
+void loop(void)
+	{
+	bus.poll_telemetry();							// a sweep a second; every response goes to read_done()
+
+	// other work goes here; bus.poll_telemetry() never blocks
+	}
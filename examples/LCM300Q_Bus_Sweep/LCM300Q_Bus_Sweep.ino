@@ -0,0 +1,106 @@
+/** ---------- LCM300Q Multi-Supply Bus Sweep ------------------------
+
+Controller is Teensy3
+
+Copyright 2026 Systronix Inc www.systronix.com
+
+Reads output voltage, current and power from every LCM300 at 0x58-0x5F on Wire1. Reads are interleaved
+across supplies by Systronix_LCM300_bus so a sweep of eight supplies takes about as long as a sweep of one.
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		bus.discover() in place of init() per address
+2026 Oct 16		empty slots stay registered; only present supplies listed
+
+--------------------------------**/
+
+#include <Arduino.h>
+#include <Systronix_LCM300_bus.h>	// best version of I2C library is #included by the library. Don't include it here!
+
+
+Systronix_LCM300		supply[LCM300_BUS_MAX_DEVICES];		// one for each possible address
+Systronix_LCM300_bus	bus;
+
+uint16_t dtime;  // delay between sweeps
+
+
+//---------------------------< R E A D _ D O N E >------------------------------------------------------------
+//
+// called by bus.tick() as each read completes; the response is dev->response_last()
+//
+
+void read_done (Systronix_LCM300* dev, int cmd_idx, uint8_t result)
+	{
+	uint16_t	raw = dev->response_last()->data.as_word;
+
+	if (SUCCESS != result)
+		{
+		Serial.printf ("0x%.2X: cmd 0x%.2X fail\n", dev->base_get(), dev->cmd[cmd_idx].cmd_byte);
+		return;
+		}
+
+	switch (cmd_idx)
+		{
+		case READ_VOUT_CMD:
+			Serial.printf ("0x%.2X: Vout: %.2fV\n", dev->base_get(), dev->raw_voltage_to_float (raw));
+			break;
+		case READ_IOUT_CMD:
+			Serial.printf ("0x%.2X: Iout: %.2fA\n", dev->base_get(), dev->pmbus_literal_to_float (raw));
+			break;
+		case READ_POUT_CMD:
+			Serial.printf ("0x%.2X: Pout: %.2fW\n", dev->base_get(), dev->pmbus_literal_to_float (raw));
+			break;
+		}
+	}
+
+
+//---------------------------< S E T U P >--------------------------------------------------------------------
+
+void setup(void)
+	{
+	Serial.begin(115200);     // use max baud rate
+	while((!Serial) && (millis()<10000));    // wait until serial monitor is open or timeout
+
+	for (uint8_t i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		supply[i].setup (LCM300_BASE_MIN + i, Wire1, (char*)"Wire1");
+		supply[i].begin(I2C_PINS_29_30);
+		}
+
+	uint8_t	found = bus.discover (supply, LCM300_BUS_MAX_DEVICES);	// probe every address; identity of all present supplies at once
+	for (uint8_t i=0; i<bus.count(); i++)
+		if (bus.device_get(i)->error.exists)			// empty slots are registered too, and re-probed in the background
+			Serial.printf ("LCM300 at 0x%.2X\n", bus.device_get(i)->base_get());
+
+	bus.callback_set (read_done);
+
+	dtime = 5000;      // msec between sweeps
+	Serial.printf ("%d supplies; interval is %d sec, setup complete\n", found, dtime/1000);
+	}
+
+
+/* ========== LOOP ========== */
+
+uint32_t	sweep_start;
+uint32_t	last_sweep;
+
+void loop(void)
+	{
+	if (bus.idle() && (millis() - last_sweep >= dtime))
+		{
+		last_sweep = sweep_start = millis();
+		Serial.printf("@%u\n", sweep_start/1000);
+		bus.queue_mask (CMD_MASK(READ_VOUT_CMD) | CMD_MASK(READ_IOUT_CMD) | CMD_MASK(READ_POUT_CMD));
+		}
+
+	if (SUCCESS == bus.tick() && sweep_start)
+		{
+		Serial.printf ("sweep: %ums\n\n", millis() - sweep_start);
+		sweep_start = 0;
+		}
+
+	// other work goes here; bus.tick() never blocks
+	}
@@ -0,0 +1,96 @@
+/******************************************************************************/
+/*!
+	@file		Arduino.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; host (Linux) stand-in for the parts of the Teensy core the library uses
+
+*/
+/******************************************************************************/
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+HostSerial	Serial;
+
+static uint64_t	clock_us = 0;								// virtual time
+static uint32_t	clock_step_us = 1;							// see host_clock_step_set()
+
+
+//---------------------------< M I L L I S ,   M I C R O S >--------------------------------------------------
+
+uint32_t micros (void)
+	{
+	uint32_t	now = (uint32_t)clock_us;					// wraps at 2^32 just like the real thing
+
+	clock_us += clock_step_us;
+	return now;
+	}
+
+
+uint32_t millis (void)
+	{
+	uint32_t	now = (uint32_t)(clock_us / 1000);
+
+	clock_us += clock_step_us;
+	return now;
+	}
+
+
+//---------------------------< D E L A Y >--------------------------------------------------------------------
+
+void delay (uint32_t ms)
+	{
+	clock_us += (uint64_t)ms * 1000;
+	}
+
+
+void delayMicroseconds (uint32_t us)
+	{
+	clock_us += us;
+	}
+
+
+void yield (void)
+	{
+	}
+
+
+//---------------------------< H O S T _ C L O C K >----------------------------------------------------------
+
+uint64_t host_clock_get (void)
+	{
+	return clock_us;
+	}
+
+
+void host_clock_advance (uint64_t us)
+	{
+	clock_us += us;
+	}
+
+
+void host_clock_step_set (uint32_t us)
+	{
+	clock_step_us = us;
+	}
+
+
+//---------------------------< P R I N T F >------------------------------------------------------------------
+
+int HostSerial::printf (const char* format, ...)
+	{
+	va_list	args;
+	int		ret_val;
+
+	if (_quiet)
+		return 0;
+
+	va_start (args, format);
+	ret_val = vprintf (format, args);
+	va_end (args);
+	return ret_val;
+	}
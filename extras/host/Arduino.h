@@ -0,0 +1,66 @@
+#ifndef HOST_ARDUINO_h
+#define HOST_ARDUINO_h
+
+/**************************************************************************************************/
+/*!
+	@file		Arduino.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; host (Linux) stand-in for the parts of the Teensy core the library uses
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  Never on the include path of a Teensy build.
+
+	Time is simulated, not read from a clock: millis() and micros() return a virtual microsecond count
+	that only moves when delay(), delayMicroseconds() or host_clock_advance() move it, plus a small
+	step (host_clock_step_set(), default 1 us) on every call to micros() / millis().  The step makes
+	code that spins on micros() waiting out the LCM300 communication interval finish after a few
+	thousand iterations instead of hanging, and keeps every run deterministic.
+***************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool		boolean;
+typedef uint8_t		byte;
+
+uint32_t	millis (void);
+uint32_t	micros (void);
+void		delay (uint32_t ms);
+void		delayMicroseconds (uint32_t us);
+void		yield (void);
+
+uint64_t	host_clock_get (void);							// virtual time in microseconds; doesn't step
+void		host_clock_advance (uint64_t us);
+void		host_clock_step_set (uint32_t us);				// amount each micros() / millis() call advances the clock
+
+
+class HostSerial										// just enough of usb_serial_class for the library and examples
+	{
+	public:
+		void		begin (long baud) {(void)baud;}
+		int			printf (const char* format, ...) __attribute__ ((format (printf, 2, 3)));
+		size_t		print (const char* s) {return fputs (s, stdout), strlen (s);}
+		size_t		print (long n) {return ::printf ("%ld", n);}
+		size_t		println (const char* s="") {return ::printf ("%s\n", s);}
+		size_t		println (long n) {return ::printf ("%ld\n", n);}
+		void		quiet (bool q) {_quiet = q;}		// host only: discard printf() output (benchmarks)
+		explicit	operator bool () const {return true;}
+
+	private:
+		bool		_quiet = false;
+	};
+
+extern HostSerial	Serial;
+
+#endif /* HOST_ARDUINO_h */
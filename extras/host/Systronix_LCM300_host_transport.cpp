@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_host_transport.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; Systronix_LCM300_transport straight to simulated slaves
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_host_transport.h>
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+
+void Systronix_LCM300_host_transport::begin (i2c_pins pins)
+	{
+	(void)pins;
+	_rate_khz = I2C_RATE_100;
+	_status = I2C_WAITING;
+	}
+
+
+//---------------------------< W R I T E >--------------------------------------------------------------------
+//
+// Blocking write; returns as endTransmission() does: 0 success, 1 too long, 2 address NAK, 3 data NAK, 4 other
+//
+
+uint8_t Systronix_LCM300_host_transport::write (uint8_t address, const uint8_t* data, size_t count)
+	{
+	if (!write_start (address, data, count, true))
+		return 1;
+	_pending_polls = 0;
+	switch (_status)
+		{
+		case I2C_WAITING:	return 0;
+		case I2C_ADDR_NAK:	return 2;
+		case I2C_DATA_NAK:	return 3;
+		default:			return 4;
+		}
+	}
+
+
+//---------------------------< W R I T E _ S T A R T >--------------------------------------------------------
+
+bool Systronix_LCM300_host_transport::write_start (uint8_t address, const uint8_t* data, size_t count, bool stop)
+	{
+	i2c_t3_host_device*	device = _device[address & 0x7F];
+
+	if (I2C_TX_BUFFER_LENGTH < count)
+		return false;
+
+	_rx_count = _rx_index = 0;
+	transaction_count++;
+	byte_count += count;
+	wire_time (count);
+	_status = device ? device->host_write (data, count, stop) : I2C_ADDR_NAK;
+	_pending_polls = _latency_polls;
+	return true;
+	}
+
+
+//---------------------------< R E A D _ S T A R T >----------------------------------------------------------
+
+void Systronix_LCM300_host_transport::read_start (uint8_t address, size_t count, bool stop)
+	{
+	i2c_t3_host_device*	device = _device[address & 0x7F];
+
+	(void)stop;
+	_rx_count = _rx_index = 0;
+	transaction_count++;
+	_pending_polls = _latency_polls;
+
+	if (I2C_RX_BUFFER_LENGTH < count)
+		count = I2C_RX_BUFFER_LENGTH;
+
+	if (!device)
+		{
+		wire_time (0);
+		_status = I2C_ADDR_NAK;
+		return;
+		}
+
+	_status = device->host_read (_rx_buf, count);
+	_rx_count = (I2C_WAITING == _status) ? count : 0;
+	byte_count += _rx_count;
+	wire_time (_rx_count);
+	}
+
+
+//---------------------------< D O N E ,   S T A T U S >------------------------------------------------------
+
+bool Systronix_LCM300_host_transport::done (void)
+	{
+	if (_pending_polls)
+		{
+		_pending_polls--;
+		return false;
+		}
+	return true;
+	}
+
+
+uint8_t Systronix_LCM300_host_transport::status (void)
+	{
+	return _pending_polls ? I2C_SENDING : _status;
+	}
+
+
+//---------------------------< A V A I L A B L E ,   R E A D >------------------------------------------------
+
+size_t Systronix_LCM300_host_transport::available (void)
+	{
+	return _pending_polls ? 0 : _rx_count - _rx_index;
+	}
+
+
+size_t Systronix_LCM300_host_transport::read (uint8_t* dest, size_t count)
+	{
+	if (count > available())
+		count = available();
+	if (dest)
+		memcpy (dest, &_rx_buf[_rx_index], count);
+	_rx_index += count;
+	return count;
+	}
+
+
+//---------------------------< R E S E T _ B U S >------------------------------------------------------------
+
+void Systronix_LCM300_host_transport::reset_bus (void)
+	{
+	reset_count++;
+	_status = I2C_WAITING;
+	_pending_polls = 0;
+	}
+
+
+//---------------------------< W I R E _ T I M E >------------------------------------------------------------
+//
+// advance the virtual clock by the time to move the address byte and count data bytes, 9 bits each
+//
+
+void Systronix_LCM300_host_transport::wire_time (size_t count)
+	{
+	if (_timing && _rate_khz)
+		host_clock_advance (((count + 1) * 9 * 1000) / _rate_khz);
+	}
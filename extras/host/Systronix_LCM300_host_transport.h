@@ -0,0 +1,68 @@
+#ifndef SYSTRONIX_LCM300_HOST_TRANSPORT_h
+#define SYSTRONIX_LCM300_HOST_TRANSPORT_h
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_host_transport.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; Systronix_LCM300_transport straight to simulated slaves
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  A Systronix_LCM300_transport with no i2c_t3 under it: transfers go straight
+	to the i2c_t3_host_device objects (Systronix_LCM300_sim) attached to it, so a net of simulated
+	supplies can be run without the i2c_t3 stand-in, and several nets without Wire / Wire1.
+
+	Transfers complete at once.  Like the i2c_t3 stand-in, each advances the virtual clock by its
+	time on the wire at rate_set() (100kHz after begin()), and write_start() / read_start() report
+	not-done for latency_set() calls to done(), so the driver's in-flight handling is exercised.
+***************************************************************************************************/
+
+#include <Systronix_LCM300_transport.h>
+
+
+class Systronix_LCM300_host_transport : public Systronix_LCM300_transport
+	{
+	protected:
+		i2c_t3_host_device*	_device[128] = {};
+		uint8_t		_rx_buf[I2C_RX_BUFFER_LENGTH];
+		size_t		_rx_count = 0;
+		size_t		_rx_index = 0;
+		i2c_status	_status = I2C_WAITING;				// of the last transfer
+		uint32_t	_pending_polls = 0;					// done() calls left before it is done
+		uint32_t	_latency_polls = 0;
+		uint32_t	_rate_khz = I2C_RATE_100;
+		bool		_timing = true;
+
+		void		wire_time (size_t count);
+
+	public:
+		uint32_t	transaction_count = 0;				// statistics
+		uint32_t	byte_count = 0;
+		uint32_t	reset_count = 0;
+
+		void		attach (uint8_t address, i2c_t3_host_device* device) {_device[address & 0x7F] = device;}
+		void		detach (uint8_t address) {_device[address & 0x7F] = NULL;}
+		void		latency_set (uint32_t polls) {_latency_polls = polls;}
+		void		rate_set (uint32_t khz) {_rate_khz = khz;}
+		void		timing_set (bool timing) {_timing = timing;}
+
+		void		begin (i2c_pins pins);
+		uint8_t		write (uint8_t address, const uint8_t* data, size_t count);
+		bool		write_start (uint8_t address, const uint8_t* data, size_t count, bool stop);
+		void		read_start (uint8_t address, size_t count, bool stop);
+		bool		done (void);
+		uint8_t		status (void);
+		size_t		available (void);
+		size_t		read (uint8_t* dest, size_t count);
+		void		reset_bus (void);
+		uint32_t	reset_bus_count (void) {return reset_count;}
+	};
+
+#endif /* SYSTRONIX_LCM300_HOST_TRANSPORT_h */
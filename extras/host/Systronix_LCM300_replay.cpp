@@ -0,0 +1,193 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_replay.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.3	2026Oct16 no memcmp() / memcpy() of a zero length record; its data pointer may be NULL
+	v0.2	2026Oct16 trace time 0 on a whole millisecond, as the recording should start, so millis() replays exactly
+	v0.1	2026Oct16 start; Systronix_LCM300_transport that answers from a recorded trace
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_replay.h>
+
+
+//---------------------------< L O A D ,   R E W I N D >------------------------------------------------------
+
+bool Systronix_LCM300_replay::load (const uint8_t* trace, size_t size)
+	{
+	if ((LCM300_TRACE_HEADER_SIZE > size) || memcmp (trace, "LCMTRC", 6) || (LCM300_TRACE_VERSION != trace[6]))
+		return false;
+
+	_trace = trace;
+	_size = size;
+	rewind();
+	return true;
+	}
+
+
+void Systronix_LCM300_replay::rewind (void)
+	{
+	_pos = LCM300_TRACE_HEADER_SIZE;
+	_time_us = 0;
+	host_clock_advance ((1000 - host_clock_get() % 1000) % 1000);	// whole millisecond; see start_ms()
+	_clock_base_us = host_clock_get();
+	_unfinished = false;
+	_rx_count = _rx_index = 0;
+	}
+
+
+//---------------------------< P E E K ,   S K I P >----------------------------------------------------------
+
+bool Systronix_LCM300_replay::peek (lcm300_trace_record_t& rec)
+	{
+	if (_pos >= _size)
+		return false;
+	if (Systronix_LCM300_recorder::decode (_trace + _pos, _size - _pos, rec))
+		return true;
+
+	damaged = _size - _pos;									// cut off or corrupt; stop here
+	_pos = _size;
+	return false;
+	}
+
+
+void Systronix_LCM300_replay::skip (void)
+	{
+	lcm300_trace_record_t	rec;
+
+	if (peek (rec))
+		{
+		_pos += Systronix_LCM300_recorder::decode (_trace + _pos, _size - _pos, rec);
+		_time_us += rec.dt_us;
+		skip_count++;
+		}
+	}
+
+
+//---------------------------< T A K E >----------------------------------------------------------------------
+//
+// Find the record that answers a transfer, use it and the ones passed over, and advance the clock to when it
+// finished.  Returns false, having used nothing, when none of the next LCM300_REPLAY_RESYNC records answers it.
+//
+
+bool Systronix_LCM300_replay::take (bool read, uint8_t address, const uint8_t* data, size_t count)
+	{
+	lcm300_trace_record_t	rec;
+	size_t		pos = _pos;
+	size_t		used;
+	size_t		compare;
+	uint64_t	time = _time_us;
+	uint64_t	done_us;
+	bool		is_read;
+	uint8_t		look;
+
+	for (look=0; (look < LCM300_REPLAY_RESYNC) && (pos < _size); look++)
+		{
+		used = Systronix_LCM300_recorder::decode (_trace + pos, _size - pos, rec);
+		if (!used)
+			break;
+		pos += used;
+		time += rec.dt_us;
+
+		is_read = (LCM300_TRACE_READ == rec.kind) || (LCM300_TRACE_READ_NOSTOP == rec.kind);
+		if ((LCM300_TRACE_RESET == rec.kind) || (is_read != read) || (rec.address != address))
+			continue;
+		compare = (count < rec.count) ? count : rec.count;
+		if (!read && compare && memcmp (rec.data, data, compare))	// rec.data is NULL for a record with no data
+			continue;
+
+		skip_count += look;
+		match_count++;
+		_pos = pos;
+		_time_us = time;
+		_status = rec.status;
+		_unfinished = rec.unfinished;
+		_rx_count = read ? rec.count : 0;
+		_rx_index = 0;
+		if (_rx_count)
+			memcpy (_rx, rec.data, _rx_count);
+
+		done_us = _clock_base_us + time + rec.duration_us;
+		if (done_us > host_clock_get())
+			host_clock_advance (done_us - host_clock_get());
+		return true;
+		}
+
+	mismatch_count++;
+	_status = I2C_ADDR_NAK;
+	_unfinished = false;
+	_rx_count = _rx_index = 0;
+	return false;
+	}
+
+
+//---------------------------< T R A N S P O R T >------------------------------------------------------------
+
+void Systronix_LCM300_replay::begin (i2c_pins pins)
+	{
+	(void)pins;
+	}
+
+
+uint8_t Systronix_LCM300_replay::write (uint8_t address, const uint8_t* data, size_t count)
+	{
+	take (false, address, data, count);
+	switch (_status)										// as endTransmission()
+		{
+		case I2C_WAITING:	return 0;
+		case I2C_ADDR_NAK:	return 2;
+		case I2C_DATA_NAK:	return 3;
+		default:			return 4;
+		}
+	}
+
+
+bool Systronix_LCM300_replay::write_start (uint8_t address, const uint8_t* data, size_t count, bool stop)
+	{
+	(void)stop;
+	take (false, address, data, count);
+	return true;
+	}
+
+
+void Systronix_LCM300_replay::read_start (uint8_t address, size_t count, bool stop)
+	{
+	(void)count; (void)stop;
+	take (true, address, NULL, 0);
+	}
+
+
+size_t Systronix_LCM300_replay::read (uint8_t* dest, size_t count)
+	{
+	if (count > available())
+		count = available();
+	if (dest)
+		memcpy (dest, &_rx[_rx_index], count);
+	_rx_index += count;
+	return count;
+	}
+
+
+//
+// A reset in the trace is used, and counted as answered, if it is next; a reset the trace doesn't have changes
+// nothing
+//
+
+void Systronix_LCM300_replay::reset_bus (void)
+	{
+	lcm300_trace_record_t	rec;
+
+	if (peek (rec) && (LCM300_TRACE_RESET == rec.kind))
+		{
+		skip();
+		skip_count--;										// used, not passed over
+		match_count++;
+		}
+	_status = I2C_WAITING;
+	_unfinished = false;
+	}
@@ -0,0 +1,85 @@
+#ifndef SYSTRONIX_LCM300_REPLAY_h
+#define SYSTRONIX_LCM300_REPLAY_h
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_replay.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 trace time 0 on a whole millisecond, as the recording should start, so millis() replays exactly
+	v0.1	2026Oct16 start; Systronix_LCM300_transport that answers from a recorded trace
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  A Systronix_LCM300_transport that plays back a trace recorded by
+	Systronix_LCM300_recorder (Systronix_LCM300_trace.h): each transfer the driver starts is matched
+	to the next record of the same kind for the same address and gets that record's status and
+	bytes, so the driver decodes exactly what the real supplies sent, quirks and all.
+
+	Matching: writes by address and the bytes both have (a PEC byte on one side only is ignored);
+	reads by address only, since the driver asks for what it expects and the trace has what came
+	back.  A transfer that matches none of the next LCM300_REPLAY_RESYNC records is a mismatch and
+	NAKs without using any record; records passed over to reach a match count as skipped.
+
+	A transfer recorded as unfinished (LCM300_TRACE_UNFINISHED) is never done() here either;
+	stalled() tells the caller to stop waiting for it, as whatever abandoned it did.
+
+	The virtual clock (Arduino.h) is moved forward to each matched record's recorded completion
+	time, so time-dependent results (the EOUT energy meter, scheduling) see the recorded timing
+	while the replay itself runs as fast as the CPU can go.  Trace time 0 is put on a whole
+	millisecond; a recording begun on one (lcm300_host_demo's is) replays with the very same
+	millis() readings, pass after pass.
+***************************************************************************************************/
+
+#include <Systronix_LCM300_trace.h>
+
+#define		LCM300_REPLAY_RESYNC	16					// records looked ahead for a match
+
+
+class Systronix_LCM300_replay : public Systronix_LCM300_transport
+	{
+	protected:
+		const uint8_t*	_trace = NULL;
+		size_t		_size = 0;
+		size_t		_pos = 0;								// next unused record
+		uint64_t	_time_us = 0;							// trace time of the last record before _pos
+		uint64_t	_clock_base_us = 0;						// virtual clock at trace time 0
+		uint8_t		_status = I2C_WAITING;					// of the last transfer
+		bool		_unfinished = false;					// the last transfer never finished
+		uint8_t		_rx[LCM300_TRACE_DATA_MAX];
+		uint8_t		_rx_count = 0;
+		uint8_t		_rx_index = 0;
+
+		bool		take (bool read, uint8_t address, const uint8_t* data, size_t count);
+
+	public:
+		uint32_t	match_count = 0;						// transfers and resets answered from the trace
+		uint32_t	mismatch_count = 0;						// transfers with no record to answer them
+		uint32_t	skip_count = 0;							// records passed over
+		uint32_t	damaged = 0;							// the trace ended in something that is not a record
+
+		bool		load (const uint8_t* trace, size_t size);	// whole trace, header included; false when not a trace
+		void		rewind (void);							// to the first record; trace time 0 is the next whole millisecond
+		bool		peek (lcm300_trace_record_t& rec);		// the next unused record; false at the end
+		void		skip (void);							// pass over the next record
+		bool		stalled (void) {return _unfinished;}	// the transfer in progress will never be done()
+		uint32_t	start_ms (void) {return _clock_base_us / 1000;}	// millis() at trace time 0; see rewind()
+
+		void		begin (i2c_pins pins);
+		uint8_t		write (uint8_t address, const uint8_t* data, size_t count);
+		bool		write_start (uint8_t address, const uint8_t* data, size_t count, bool stop);
+		void		read_start (uint8_t address, size_t count, bool stop);
+		bool		done (void) {return !_unfinished;}
+		uint8_t		status (void) {return _status;}
+		size_t		available (void) {return _rx_count - _rx_index;}
+		size_t		read (uint8_t* dest, size_t count);
+		void		reset_bus (void);
+		uint32_t	reset_bus_count (void) {return 0;}
+	};
+
+#endif /* SYSTRONIX_LCM300_REPLAY_h */
@@ -0,0 +1,481 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_LCM300_sim.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.4	2026Oct16 energy_ws(): energy delivered, to check the driver's READ_EOUT meter against
+	v0.3	2026Oct16 attach to a Systronix_LCM300_host_transport
+	v0.2	2026Oct16 writes: WRITE_PROTECT, read-only registers, READ_VOUT follows VOUT_COMMAND / OPERATION
+	v0.1	2026Oct16 start; register-level LCM300 simulator for host builds
+
+*/
+/******************************************************************************/
+
+#include <Systronix_LCM300_sim.h>
+#include <Systronix_LCM300.h>
+
+
+//---------------------------< S Y S T R O N I X _ L C M 3 0 0 _ S I M >--------------------------------------
+//
+// An LCM300Q at 24V, 150W
+//
+
+Systronix_LCM300_sim::Systronix_LCM300_sim (void)
+	{
+	memset (_reg, 0, sizeof(_reg));
+	_address = 0;
+	_cmd = 0;
+	_eout_watts = 150.0;
+	_eout_rate_hz = 1000.0;
+	_eout_energy = 0;
+	_eout_samples = 0;
+	_eout_last_us = host_clock_get();
+	_energy_ws = 0;
+	_nak_next = _timeout_next = _short_read_next = _pec_corrupt_next = 0;
+	_block_length_next = -1;
+	_vout_offset = 0.04;
+	read_count = write_count = clear_faults_count = 0;
+
+	byte_set (LCM300_PAGE_CMD, 0x00);
+	byte_set (LCM300_OPERATION_CMD, 0x80);
+	byte_set (LCM300_WRITE_PROTECT_CMD, LCM300_WP_DISABLE_ALL);
+	vout_mode_set (-9);										// 0x17
+	word_set (VOUT_COMMAND_CMD_VAL, 0x3000);				// 24.0V
+	word_set (VOUT_MAX_CMD_VAL, 0x3999);					// 28.8V
+	word_set (VOUT_MARGIN_HIGH_CMD_VAL, 0x3266);			// 25.2V
+	word_set (VOUT_MARGIN_LOW_CMD_VAL, 0x2D9A);				// 22.8V
+	word_set (FAN_COMMAND_1, 0);
+	word_set (READ_VOUT_CMD_VAL, 0x3014);					// 24.04V
+	linear11_set (READ_IOUT_CMD_VAL, 6.25);
+	linear11_set (READ_TEMPERATURE_2_CMD_VAL, 35.0);
+	word_set (READ_FAN_SPEED_CMD_VAL, 6873);				// direct
+	pout_set (150.0);
+	string_set (MFR_ID_CMD_VAL, "Artesyn");
+	string_set (MFR_MODEL_CMD_VAL, "LCM300Q-T");
+	string_set (MFR_REVISION_CMD_VAL, "0A");
+	string_set (MFR_LOCATION_CMD_VAL, "Philippines");
+	string_set (MFR_DATE_CMD_VAL, "180321");
+	string_set (MFR_SERIAL_CMD_VAL, "123456789ABCD");
+	byte_set (PMBUS_REVISION_CMD_VAL, 0x22);
+	word_set (MFR_VOUT_MIN_CMD_VAL, 0x2666);				// 19.2V
+	word_set (MFR_VOUT_MAX_CMD_VAL, 0x3999);				// 28.8V
+	word_set (MFR_IOUT_MAX_CMD_VAL, 0xD3A0);				// 14.5A
+	byte_set (STATUS_BYTE_CMD_VAL, 0);
+	word_set (STATUS_WORD_CMD_VAL, 0);
+	byte_set (STATUS_VOUT_CMD_VAL, 0);
+	byte_set (STATUS_IOUT_CMD_VAL, 0);
+	byte_set (STATUS_TEMP_CMD_VAL, 0);
+
+	_reg[READ_EOUT_CMD_VAL].implemented = true;				// computed by host_read()
+	_reg[READ_EOUT_CMD_VAL].block = true;
+	_reg[READ_EOUT_CMD_VAL].count = EOUT;
+	}
+
+
+//---------------------------< A T T A C H ,   D E T A C H >--------------------------------------------------
+
+void Systronix_LCM300_sim::attach (i2c_t3& wire, uint8_t address)
+	{
+	_address = address;
+	wire.host_attach (address, this);
+	}
+
+
+void Systronix_LCM300_sim::detach (i2c_t3& wire)
+	{
+	wire.host_detach (_address);
+	}
+
+
+void Systronix_LCM300_sim::attach (Systronix_LCM300_host_transport& transport, uint8_t address)
+	{
+	_address = address;
+	transport.attach (address, this);
+	}
+
+
+void Systronix_LCM300_sim::detach (Systronix_LCM300_host_transport& transport)
+	{
+	transport.detach (_address);
+	}
+
+
+//---------------------------< R E G I S T E R   V A L U E S >------------------------------------------------
+
+void Systronix_LCM300_sim::byte_set (uint8_t cmd, uint8_t value)
+	{
+	_reg[cmd].data[0] = value;
+	_reg[cmd].count = 1;
+	_reg[cmd].implemented = true;
+	_reg[cmd].block = false;
+	}
+
+
+void Systronix_LCM300_sim::word_set (uint8_t cmd, uint16_t value)
+	{
+	_reg[cmd].data[0] = (uint8_t)value;
+	_reg[cmd].data[1] = (uint8_t)(value >> 8);
+	_reg[cmd].count = 2;
+	_reg[cmd].implemented = true;
+	_reg[cmd].block = false;
+	}
+
+
+void Systronix_LCM300_sim::string_set (uint8_t cmd, const char* value)
+	{
+	size_t	length = strlen (value);
+
+	if (sizeof(_reg[cmd].data) - 1 < length)
+		length = sizeof(_reg[cmd].data) - 1;
+
+	_reg[cmd].data[0] = (uint8_t)length;
+	memcpy (&_reg[cmd].data[1], value, length);
+	_reg[cmd].count = (uint8_t)(length + 1);
+	_reg[cmd].implemented = true;
+	_reg[cmd].block = true;
+	}
+
+
+uint16_t Systronix_LCM300_sim::word_get (uint8_t cmd)
+	{
+	return (uint16_t)(_reg[cmd].data[0] | (_reg[cmd].data[1] << 8));
+	}
+
+
+uint8_t Systronix_LCM300_sim::byte_get (uint8_t cmd)
+	{
+	return _reg[cmd].data[0];
+	}
+
+
+void Systronix_LCM300_sim::vout_mode_set (int8_t exponent)
+	{
+	byte_set (VOUT_MODE_CMD_VAL, (uint8_t)exponent & 0x1F);	// mode bits 000: linear
+	}
+
+
+int8_t Systronix_LCM300_sim::vout_exponent_get (void)
+	{
+	uint8_t	raw = byte_get (VOUT_MODE_CMD_VAL);
+
+	return (raw & 0x10) ? (int8_t)(raw | 0xE0) : (int8_t)(raw & 0x1F);
+	}
+
+
+void Systronix_LCM300_sim::vout_set (uint8_t cmd, float volts)
+	{
+	word_set (cmd, linear16_encode (volts, vout_exponent_get()));
+	}
+
+
+void Systronix_LCM300_sim::linear11_set (uint8_t cmd, float value)
+	{
+	word_set (cmd, linear11_encode (value));
+	}
+
+
+void Systronix_LCM300_sim::pout_set (float watts)
+	{
+	eout_update ();											// integrate the old power up to now
+	_eout_watts = watts;
+	linear11_set (READ_POUT_CMD_VAL, watts);
+	}
+
+
+void Systronix_LCM300_sim::vout_offset_set (float volts)
+	{
+	_vout_offset = volts;
+	output_update ();
+	}
+
+
+void Systronix_LCM300_sim::eout_rate_set (float samples_per_second)
+	{
+	eout_update ();
+	_eout_rate_hz = samples_per_second;
+	}
+
+
+void Systronix_LCM300_sim::eout_state_set (double energy, double samples)
+	{
+	_eout_energy = energy;
+	_eout_samples = samples;
+	_eout_last_us = host_clock_get();
+	}
+
+
+//---------------------------< L I N E A R 1 1 _ E N C O D E >------------------------------------------------
+//
+// The smallest exponent that fits the mantissa in 11 signed bits gives the most precision.
+//
+
+uint16_t Systronix_LCM300_sim::linear11_encode (float value)
+	{
+	int		exponent;
+	long	mantissa;
+
+	for (exponent = -16; exponent < 15; exponent++)
+		{
+		mantissa = lroundf (ldexpf (value, -exponent));
+		if ((-1024 <= mantissa) && (1023 >= mantissa))
+			break;
+		}
+	mantissa = lroundf (ldexpf (value, -exponent));
+
+	return (uint16_t)(((exponent & 0x1F) << 11) | (mantissa & 0x07FF));
+	}
+
+
+uint16_t Systronix_LCM300_sim::linear16_encode (float value, int8_t exponent)
+	{
+	long	mantissa = lroundf (ldexpf (value, -exponent));
+
+	if (0 > mantissa)
+		mantissa = 0;
+	if (0xFFFF < mantissa)
+		mantissa = 0xFFFF;
+	return (uint16_t)mantissa;
+	}
+
+
+//---------------------------< F A U L T   I N J E C T I O N >------------------------------------------------
+
+void Systronix_LCM300_sim::nak_next (uint32_t count)			{_nak_next = count;}
+void Systronix_LCM300_sim::timeout_next (uint32_t count)		{_timeout_next = count;}
+void Systronix_LCM300_sim::short_read_next (uint32_t count)		{_short_read_next = count;}
+void Systronix_LCM300_sim::pec_corrupt_next (uint32_t count)	{_pec_corrupt_next = count;}
+void Systronix_LCM300_sim::block_length_next (uint8_t length)	{_block_length_next = length;}
+
+
+//---------------------------< E O U T _ U P D A T E >--------------------------------------------------------
+//
+// integrate power over the virtual time since the last update
+//
+
+void Systronix_LCM300_sim::eout_update (void)
+	{
+	uint64_t	now = host_clock_get();
+	double		samples = (double)(now - _eout_last_us) * _eout_rate_hz / 1000000.0;
+
+	_eout_samples += samples;
+	_eout_energy += samples * _eout_watts;
+	_energy_ws += (double)(now - _eout_last_us) * _eout_watts / 1000000.0;
+	_eout_last_us = now;
+	}
+
+
+double Systronix_LCM300_sim::energy_ws (void)
+	{
+	eout_update ();
+	return _energy_ws;
+	}
+
+
+//---------------------------< P E C >------------------------------------------------------------------------
+
+uint8_t Systronix_LCM300_sim::pec (uint8_t cmd, const uint8_t* data, size_t count)
+	{
+	uint8_t	header[3] = {(uint8_t)(_address << 1), cmd, (uint8_t)((_address << 1) | 1)};
+
+	return Systronix_LCM300::pec_crc8 (Systronix_LCM300::pec_crc8 (0, header, 3), data, count);
+	}
+
+
+//---------------------------< H O S T _ W R I T E >----------------------------------------------------------
+//
+// A command byte alone without a stop is the first half of a read.  With a stop it is a send-byte command
+// (CLEAR_FAULTS), optionally followed by PEC.  Anything longer is a write of the bytes after the command byte.
+//
+
+i2c_status Systronix_LCM300_sim::host_write (const uint8_t* data, size_t count, bool stop)
+	{
+	uint8_t	pec_header[2] = {(uint8_t)(_address << 1), 0};
+	size_t	data_count;
+
+	if (0 == count)											// address-only probe
+		return I2C_WAITING;
+
+	if (_nak_next)
+		{
+		_nak_next--;
+		return I2C_DATA_NAK;
+		}
+
+	_cmd = data[0];
+	if (!stop)
+		return I2C_WAITING;									// read follows
+
+	write_count++;
+	if (LCM300_CLEAR_FAULTS_CMD == _cmd)
+		{
+		if (2 == count)										// with PEC
+			{
+			pec_header[1] = _cmd;
+			if (data[1] != Systronix_LCM300::pec_crc8 (0, pec_header, 2))
+				return I2C_DATA_NAK;
+			}
+		clear_faults_count++;
+		byte_set (STATUS_BYTE_CMD_VAL, 0);
+		word_set (STATUS_WORD_CMD_VAL, 0);
+		byte_set (STATUS_VOUT_CMD_VAL, 0);
+		byte_set (STATUS_IOUT_CMD_VAL, 0);
+		byte_set (STATUS_TEMP_CMD_VAL, 0);
+		return I2C_WAITING;
+		}
+
+	data_count = count - 1;
+	if (!_reg[_cmd].implemented || _reg[_cmd].block || !writable (_cmd))
+		return I2C_DATA_NAK;
+
+	if (data_count == _reg[_cmd].count + 1u)				// with PEC
+		{
+		if (data[count - 1] != Systronix_LCM300::pec_crc8 (Systronix_LCM300::pec_crc8 (0, pec_header, 1), data, count - 1))
+			return I2C_DATA_NAK;
+		}
+	else if (data_count != _reg[_cmd].count)
+		return I2C_DATA_NAK;
+
+	switch (byte_get (LCM300_WRITE_PROTECT_CMD))
+		{
+		case LCM300_WP_ENABLE_ALL:
+			break;
+		case LCM300_WP_ENABLE_OPER_PAGE_ONOFF_VOUT:
+			if ((LCM300_PAGE_CMD == _cmd) || (LCM300_OPERATION_CMD == _cmd) || (VOUT_COMMAND_CMD_VAL == _cmd) ||
+				(LCM300_WRITE_PROTECT_CMD == _cmd))
+				break;
+			// fall through
+		case LCM300_WP_ENABLE_OPER_PAGE:
+			if ((LCM300_PAGE_CMD == _cmd) || (LCM300_OPERATION_CMD == _cmd) || (LCM300_WRITE_PROTECT_CMD == _cmd))
+				break;
+			// fall through
+		default:
+			if (LCM300_WRITE_PROTECT_CMD == _cmd)
+				break;
+			byte_set (STATUS_BYTE_CMD_VAL, byte_get (STATUS_BYTE_CMD_VAL) | 0x02);	// CML
+			word_set (STATUS_WORD_CMD_VAL, word_get (STATUS_WORD_CMD_VAL) | 0x0002);
+			return I2C_WAITING;								// ACKed but ignored
+		}
+
+	memcpy (_reg[_cmd].data, &data[1], _reg[_cmd].count);
+	output_update ();
+	return I2C_WAITING;
+	}
+
+
+//---------------------------< W R I T A B L E >--------------------------------------------------------------
+
+bool Systronix_LCM300_sim::writable (uint8_t cmd)
+	{
+	switch (cmd)
+		{
+		case LCM300_PAGE_CMD:
+		case LCM300_OPERATION_CMD:
+		case LCM300_WRITE_PROTECT_CMD:
+		case VOUT_COMMAND_CMD_VAL:
+		case VOUT_MARGIN_HIGH_CMD_VAL:
+		case VOUT_MARGIN_LOW_CMD_VAL:
+		case FAN_COMMAND_1:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+
+//---------------------------< O U T P U T _ U P D A T E >----------------------------------------------------
+//
+// READ_VOUT from OPERATION and the voltage it selects.
+//
+
+void Systronix_LCM300_sim::output_update (void)
+	{
+	uint8_t	operation = byte_get (LCM300_OPERATION_CMD);
+	uint8_t	select = VOUT_COMMAND_CMD_VAL;
+	float	volts;
+
+	if (!(operation & 0x80))								// off
+		{
+		word_set (READ_VOUT_CMD_VAL, 0);
+		return;
+		}
+
+	if (0x10 == (operation & 0x30))							// bits 5:4 select the margin
+		select = VOUT_MARGIN_LOW_CMD_VAL;
+	else if (0x20 == (operation & 0x30))
+		select = VOUT_MARGIN_HIGH_CMD_VAL;
+
+	volts = word_get (select) * exp2f (vout_exponent_get()) + _vout_offset;
+	vout_set (READ_VOUT_CMD_VAL, volts);
+	}
+
+
+//---------------------------< H O S T _ R E A D >------------------------------------------------------------
+//
+// Response to the command written by host_write(): the data, PEC, then 0xFF for as long as the master keeps
+// reading.  Unimplemented commands return 0xFF.
+//
+
+i2c_status Systronix_LCM300_sim::host_read (uint8_t* data, size_t& count)
+	{
+	uint8_t		response[sizeof(_reg[0].data) + 1];
+	uint8_t		length;
+	uint64_t	energy;
+	uint64_t	samples;
+	size_t		i;
+
+	read_count++;
+
+	if (_timeout_next)
+		{
+		_timeout_next--;
+		return I2C_TIMEOUT;
+		}
+
+	if (READ_EOUT_CMD_VAL == _cmd)
+		{
+		eout_update ();
+		energy = (uint64_t)_eout_energy;
+		samples = (uint64_t)_eout_samples;
+		_reg[_cmd].data[0] = EOUT - 1;
+		_reg[_cmd].data[1] = (uint8_t)(energy % 32767);		// accumulator, 0..32766
+		_reg[_cmd].data[2] = (uint8_t)((energy % 32767) >> 8);
+		_reg[_cmd].data[3] = (uint8_t)(energy / 32767);		// rollover count, 8 bits
+		_reg[_cmd].data[4] = (uint8_t)samples;				// sample count, 24 bits
+		_reg[_cmd].data[5] = (uint8_t)(samples >> 8);
+		_reg[_cmd].data[6] = (uint8_t)(samples >> 16);
+		}
+
+	length = _reg[_cmd].implemented ? _reg[_cmd].count : 0;
+	memcpy (response, _reg[_cmd].data, length);
+
+	if (_reg[_cmd].block && (0 <= _block_length_next))
+		{
+		response[0] = (uint8_t)_block_length_next;			// bogus length byte; block reads only
+		_block_length_next = -1;
+		}
+
+	if (length)
+		{
+		response[length] = pec (_cmd, response, length);
+		if (_pec_corrupt_next)
+			{
+			_pec_corrupt_next--;
+			response[length] ^= 0x5A;
+			}
+		length++;
+		}
+
+	for (i=0; i<count; i++)
+		data[i] = (i < length) ? response[i] : 0xFF;
+
+	if (_short_read_next && count)
+		{
+		_short_read_next--;
+		count--;
+		}
+
+	return I2C_WAITING;
+	}
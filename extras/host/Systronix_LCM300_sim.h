@@ -0,0 +1,123 @@
+#ifndef SYSTRONIX_LCM300_SIM_h
+#define SYSTRONIX_LCM300_SIM_h
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_LCM300_sim.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.4	2026Oct16 energy_ws(): energy delivered, to check the driver's READ_EOUT meter against
+	v0.3	2026Oct16 attach to a Systronix_LCM300_host_transport
+	v0.2	2026Oct16 writes: WRITE_PROTECT, read-only registers, READ_VOUT follows VOUT_COMMAND / OPERATION
+	v0.1	2026Oct16 start; register-level LCM300 simulator for host builds
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  A simulated LCM300 that attaches to the host i2c_t3 stand-in at any address
+	and answers PMBus commands the way the real supply does, as far as we know it:
+
+	- byte and word commands return their value, little-endian
+	- ascii commands are block reads: length byte, then the string, not null terminated
+	- READ_EOUT is a 6-byte block: 15-bit accumulator, 8-bit rollover count, 24-bit sample count,
+	  computed from the simulated output power and sample rate against the virtual clock so that
+	  accumulator and rollover counter wrap just as they do on the real supply
+	- after the data comes the PEC byte (the "consistent value <0xFF" seen in raw reads), then 0xFF
+	- CLEAR_FAULTS clears the status registers
+	- writes to read-only registers are NAKed; writes that WRITE_PROTECT forbids are ACKed, ignored,
+	  and flagged CML in STATUS_BYTE / STATUS_WORD, so only a read back shows they didn't take
+	- READ_VOUT follows VOUT_COMMAND, VOUT_MARGIN_HIGH / LOW, and OPERATION (0 when off) plus a fixed
+	  offset, as a supply trimmed against a remote sense drop would
+
+	Defaults are those of an LCM300Q (24V) as read from real supplies; the *_set() functions change
+	them.  The *_next() functions inject faults into upcoming transactions: NAKs, bus timeouts,
+	short reads, bogus block length bytes, bad PEC.
+***************************************************************************************************/
+
+#include <i2c_t3.h>
+#include <Systronix_LCM300_host_transport.h>
+
+
+class Systronix_LCM300_sim : public i2c_t3_host_device
+	{
+	protected:
+		struct reg_t
+			{
+			uint8_t		data[20];							// block reads: length byte first
+			uint8_t		count;								// bytes in data[]
+			bool		implemented;
+			bool		block;								// block read: data[0] is the length byte
+			} _reg[256];
+
+		uint8_t		_address;
+		uint8_t		_cmd;									// command byte of the read in progress
+
+		double		_eout_watts;							// power integrated by READ_EOUT
+		double		_eout_rate_hz;							// READ_EOUT samples per second
+		double		_eout_energy;							// watt-samples since power up
+		double		_eout_samples;							// samples since power up
+		uint64_t	_eout_last_us;							// virtual time of last update
+		double		_energy_ws;								// watt-seconds delivered since power up
+
+		float		_vout_offset;							// READ_VOUT - the selected output voltage
+
+		uint32_t	_nak_next;
+		uint32_t	_timeout_next;
+		uint32_t	_short_read_next;
+		uint32_t	_pec_corrupt_next;
+		int16_t		_block_length_next;						// -1 when none
+
+		void		eout_update (void);
+		uint8_t		pec (uint8_t cmd, const uint8_t* data, size_t count);
+		bool		writable (uint8_t cmd);
+		void		output_update (void);
+
+	public:
+		uint32_t	read_count;								// statistics
+		uint32_t	write_count;
+		uint32_t	clear_faults_count;
+
+					Systronix_LCM300_sim (void);
+
+		void		attach (i2c_t3& wire, uint8_t address);
+		void		detach (i2c_t3& wire);
+		void		attach (Systronix_LCM300_host_transport& transport, uint8_t address);
+		void		detach (Systronix_LCM300_host_transport& transport);
+
+		// register values
+		void		byte_set (uint8_t cmd, uint8_t value);
+		void		word_set (uint8_t cmd, uint16_t value);
+		void		string_set (uint8_t cmd, const char* value);
+		uint16_t	word_get (uint8_t cmd);
+		uint8_t		byte_get (uint8_t cmd);
+
+		void		vout_mode_set (int8_t exponent);		// linear mode, exponent -16..15
+		int8_t		vout_exponent_get (void);
+		void		vout_set (uint8_t cmd, float volts);	// encode with the VOUT_MODE exponent
+		void		linear11_set (uint8_t cmd, float value);
+		void		pout_set (float watts);					// READ_POUT and the power integrated by READ_EOUT
+		void		eout_rate_set (float samples_per_second);
+		void		eout_state_set (double energy, double samples);	// jump the accumulator e.g. to just short of a rollover
+		void		vout_offset_set (float volts);			// READ_VOUT - selected output voltage; updates READ_VOUT
+		double		energy_ws (void);						// watt-seconds delivered since power up; what READ_EOUT measures
+
+		static uint16_t	linear11_encode (float value);
+		static uint16_t	linear16_encode (float value, int8_t exponent);
+
+		// fault injection; each applies to the next count transactions
+		void		nak_next (uint32_t count);				// data NAK the command byte
+		void		timeout_next (uint32_t count);			// read times out
+		void		short_read_next (uint32_t count);		// read returns one byte less than requested
+		void		pec_corrupt_next (uint32_t count);		// read returns a bad PEC byte
+		void		block_length_next (uint8_t length);		// next block read returns this length byte
+
+		// i2c_t3_host_device
+		i2c_status	host_write (const uint8_t* data, size_t count, bool stop);
+		i2c_status	host_read (uint8_t* data, size_t& count);
+	};
+
+#endif /* SYSTRONIX_LCM300_SIM_h */
@@ -0,0 +1,48 @@
+/******************************************************************************/
+/*!
+	@file		Systronix_i2c_common.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; host (Linux) stand-in for the Systronix_i2c_common library
+
+*/
+/******************************************************************************/
+
+#include <Systronix_i2c_common.h>
+
+Systronix_i2c_common	i2c_common;
+
+
+//---------------------------< T A L L Y _ T R A N S A C T I O N >--------------------------------------------
+//
+// value is SUCCESS, one of our error values, or an i2c_t3 i2c_status value
+//
+
+void Systronix_i2c_common::tally_transaction (uint8_t value, error_t* error_ptr)
+	{
+	if (SUCCESS == value)
+		{
+		error_ptr->successful_count++;
+		return;
+		}
+
+	error_ptr->error_val = value;
+	error_ptr->total_error_count++;
+
+	switch (value)
+		{
+		case WR_INCOMPLETE:		error_ptr->incomplete_write_count++;	break;
+		case SILLY_PROGRAMMER:	error_ptr->silly_programmer_error++;	break;
+		case I2C_TIMEOUT:		error_ptr->timeout_count++;				break;
+		case I2C_ADDR_NAK:		error_ptr->rcv_addr_nack_count++;		break;
+		case I2C_DATA_NAK:		error_ptr->rcv_data_nack_count++;		break;
+		case I2C_ARB_LOST:		error_ptr->arbitration_lost_count++;	break;
+		case I2C_BUF_OVF:		error_ptr->buffer_overflow_count++;		break;
+		case I2C_NOT_ACQ:
+		case I2C_DMA_ERR:		error_ptr->other_error_count++;			break;
+		default:				error_ptr->unknown_error_count++;		break;
+		}
+	}
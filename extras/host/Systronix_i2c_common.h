@@ -0,0 +1,59 @@
+#ifndef HOST_SYSTRONIX_I2C_COMMON_h
+#define HOST_SYSTRONIX_I2C_COMMON_h
+
+/**************************************************************************************************/
+/*!
+	@file		Systronix_i2c_common.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.1	2026Oct16 start; host (Linux) stand-in for the Systronix_i2c_common library
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  The return values, error_t counters and tally_transaction() that the LCM300
+	library uses, nothing more.  On target the real Systronix_i2c_common library is used.
+***************************************************************************************************/
+
+#include <Arduino.h>
+#include <i2c_t3.h>
+
+#define		SUCCESS				0
+#define		FAIL				(~SUCCESS)
+#define		ABSENT				0xFD
+
+#define		WR_INCOMPLETE		11
+#define		SILLY_PROGRAMMER	12
+
+struct error_t
+	{
+	boolean		exists;								// set false after an unsuccessful i2c transaction
+	uint8_t		error_val;							// the most recent error value
+	uint32_t	incomplete_write_count;
+	uint32_t	data_len_error_count;
+	uint32_t	timeout_count;
+	uint32_t	rcv_addr_nack_count;
+	uint32_t	rcv_data_nack_count;
+	uint32_t	arbitration_lost_count;
+	uint32_t	buffer_overflow_count;
+	uint32_t	other_error_count;
+	uint32_t	unknown_error_count;
+	uint32_t	silly_programmer_error;
+	uint64_t	total_error_count;
+	uint64_t	successful_count;
+	};
+
+
+class Systronix_i2c_common
+	{
+	public:
+		void		tally_transaction (uint8_t value, error_t* error_ptr);
+	};
+
+extern Systronix_i2c_common i2c_common;
+
+#endif /* HOST_SYSTRONIX_I2C_COMMON_h */
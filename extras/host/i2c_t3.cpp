@@ -0,0 +1,273 @@
+/******************************************************************************/
+/*!
+	@file		i2c_t3.cpp
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 setOpMode()
+	v0.1	2026Oct16 start; host (Linux) stand-in for the i2c_t3 Teensy I2C library
+
+*/
+/******************************************************************************/
+
+#include <i2c_t3.h>
+
+static i2c_t3_host_bus	bus_state[2];				// Wire, Wire1
+
+i2c_t3	Wire (0);
+i2c_t3	Wire1 (1);
+
+
+//---------------------------< I 2 C _ T 3 >------------------------------------------------------------------
+
+i2c_t3::i2c_t3 (uint8_t bus_num)
+	{
+	_bus = &bus_state[bus_num];
+	_bus->rate_khz = I2C_RATE_100;
+	_bus->timing = true;
+	}
+
+
+//---------------------------< B E G I N >--------------------------------------------------------------------
+
+void i2c_t3::begin (i2c_mode mode, uint8_t address, i2c_pins pins, i2c_pullup pullup, i2c_rate rate)
+	{
+	(void)mode; (void)address; (void)pins; (void)pullup;
+	_bus->rate_khz = rate;
+	_bus->current_status = I2C_WAITING;
+	}
+
+
+//---------------------------< M A S T E R   W R I T E >------------------------------------------------------
+
+void i2c_t3::beginTransmission (uint8_t address)
+	{
+	_bus->tx_addr = address;
+	_bus->tx_count = 0;
+	}
+
+
+size_t i2c_t3::write (uint8_t data)
+	{
+	if (I2C_TX_BUFFER_LENGTH <= _bus->tx_count)
+		{
+		_bus->current_status = I2C_BUF_OVF;
+		return 0;
+		}
+	_bus->tx_buf[_bus->tx_count++] = data;
+	return 1;
+	}
+
+
+size_t i2c_t3::write (const uint8_t* data, size_t count)
+	{
+	size_t	i;
+
+	for (i=0; i<count; i++)
+		{
+		if (!write (data[i]))
+			break;
+		}
+	return i;
+	}
+
+
+//---------------------------< E N D T R A N S M I S S I O N >------------------------------------------------
+//
+// returns as the Arduino Wire library does: 0 success, 2 address NAK, 3 data NAK, 4 other error
+//
+
+uint8_t i2c_t3::endTransmission (i2c_stop send_stop)
+	{
+	return endTransmission (send_stop, _default_timeout);
+	}
+
+
+uint8_t i2c_t3::endTransmission (i2c_stop send_stop, uint32_t timeout)
+	{
+	(void)timeout;
+	deliver_write (send_stop);
+	return getError();
+	}
+
+
+void i2c_t3::sendTransmission (i2c_stop send_stop)
+	{
+	deliver_write (send_stop);
+	_bus->pending_polls = _bus->latency_polls;
+	}
+
+
+//---------------------------< M A S T E R   R E A D >--------------------------------------------------------
+
+size_t i2c_t3::requestFrom (uint8_t address, size_t count, i2c_stop send_stop)
+	{
+	return requestFrom (address, count, send_stop, _default_timeout);
+	}
+
+
+size_t i2c_t3::requestFrom (uint8_t address, size_t count, i2c_stop send_stop, uint32_t timeout)
+	{
+	(void)timeout;
+	deliver_read (address, count, send_stop);
+	return _bus->rx_count;
+	}
+
+
+void i2c_t3::sendRequest (uint8_t address, size_t count, i2c_stop send_stop)
+	{
+	deliver_read (address, count, send_stop);
+	_bus->pending_polls = _bus->latency_polls;
+	}
+
+
+//---------------------------< D O N E ,   F I N I S H ,   S T A T U S >--------------------------------------
+
+uint8_t i2c_t3::done (void)
+	{
+	if (_bus->pending_polls)
+		{
+		_bus->pending_polls--;
+		return 0;
+		}
+	return 1;
+	}
+
+
+uint8_t i2c_t3::finish (uint32_t timeout)
+	{
+	(void)timeout;
+	_bus->pending_polls = 0;
+	return (I2C_WAITING == _bus->current_status);
+	}
+
+
+i2c_status i2c_t3::status (void)
+	{
+	if (_bus->pending_polls)
+		return I2C_SENDING;
+	return _bus->current_status;
+	}
+
+
+uint8_t i2c_t3::getError (void)
+	{
+	switch (_bus->current_status)
+		{
+		case I2C_WAITING:	return 0;
+		case I2C_ADDR_NAK:	return 2;
+		case I2C_DATA_NAK:	return 3;
+		default:			return 4;
+		}
+	}
+
+
+//---------------------------< R E C E I V E   B U F F E R >--------------------------------------------------
+
+int i2c_t3::available (void)
+	{
+	if (_bus->pending_polls)
+		return 0;
+	return (int)(_bus->rx_count - _bus->rx_index);
+	}
+
+
+uint8_t i2c_t3::readByte (void)
+	{
+	return (_bus->rx_index < _bus->rx_count) ? _bus->rx_buf[_bus->rx_index++] : 0;
+	}
+
+
+int i2c_t3::read (void)
+	{
+	return (_bus->rx_index < _bus->rx_count) ? _bus->rx_buf[_bus->rx_index++] : -1;
+	}
+
+
+int i2c_t3::peek (void)
+	{
+	return (_bus->rx_index < _bus->rx_count) ? _bus->rx_buf[_bus->rx_index] : -1;
+	}
+
+
+//---------------------------< R E S E T B U S >--------------------------------------------------------------
+
+void i2c_t3::resetBus (void)
+	{
+	_bus->reset_count++;
+	_bus->current_status = I2C_WAITING;
+	_bus->pending_polls = 0;
+	}
+
+
+//---------------------------< H O S T _ A T T A C H >--------------------------------------------------------
+
+void i2c_t3::host_attach (uint8_t address, i2c_t3_host_device* device)
+	{
+	_bus->device[address & 0x7F] = device;
+	}
+
+
+void i2c_t3::host_detach (uint8_t address)
+	{
+	_bus->device[address & 0x7F] = NULL;
+	}
+
+
+//---------------------------< D E L I V E R _ W R I T E >----------------------------------------------------
+
+void i2c_t3::deliver_write (i2c_stop send_stop)
+	{
+	i2c_t3_host_device*	device = _bus->device[_bus->tx_addr & 0x7F];
+
+	_bus->rx_count = _bus->rx_index = 0;
+	_bus->transaction_count++;
+	_bus->byte_count += _bus->tx_count;
+	wire_time (_bus->tx_count);
+
+	if (!device)
+		_bus->current_status = I2C_ADDR_NAK;
+	else
+		_bus->current_status = device->host_write (_bus->tx_buf, _bus->tx_count, (I2C_STOP == send_stop));
+	}
+
+
+//---------------------------< D E L I V E R _ R E A D >------------------------------------------------------
+
+void i2c_t3::deliver_read (uint8_t address, size_t count, i2c_stop send_stop)
+	{
+	i2c_t3_host_device*	device = _bus->device[address & 0x7F];
+
+	(void)send_stop;
+	_bus->rx_count = _bus->rx_index = 0;
+	_bus->transaction_count++;
+
+	if (I2C_RX_BUFFER_LENGTH < count)
+		count = I2C_RX_BUFFER_LENGTH;
+
+	if (!device)
+		{
+		wire_time (0);
+		_bus->current_status = I2C_ADDR_NAK;
+		return;
+		}
+
+	_bus->current_status = device->host_read (_bus->rx_buf, count);
+	_bus->rx_count = (I2C_WAITING == _bus->current_status) ? count : 0;
+	_bus->byte_count += _bus->rx_count;
+	wire_time (_bus->rx_count);
+	}
+
+
+//---------------------------< W I R E _ T I M E >------------------------------------------------------------
+//
+// advance the virtual clock by the time to move the address byte and count data bytes, 9 bits each
+//
+
+void i2c_t3::wire_time (size_t count)
+	{
+	if (_bus->timing && _bus->rate_khz)
+		host_clock_advance (((count + 1) * 9 * 1000) / _bus->rate_khz);
+	}
@@ -0,0 +1,141 @@
+#ifndef HOST_I2C_T3_H
+#define HOST_I2C_T3_H
+
+/**************************************************************************************************/
+/*!
+	@file		i2c_t3.h
+
+	@author		B Boyes (Systronix Inc)
+	@license	TBD (see license.txt)
+	@section	HISTORY
+
+	v0.2	2026Oct16 setOpMode()
+	v0.1	2026Oct16 start; host (Linux) stand-in for the i2c_t3 Teensy I2C library
+
+*/
+/**************************************************************************************************/
+
+/***************************************************************************************************
+	Host builds only.  The subset of the i2c_t3 master API used by the library, with the same names,
+	enums, and return conventions, talking to simulated slaves instead of hardware.
+
+	Slaves are i2c_t3_host_device objects attached to an address with host_attach().  An address with
+	nothing attached NAKs.  Like the real library, every i2c_t3 object for one bus (Wire, Wire1, and
+	copies of them) shares one bus state.
+
+	Timing: each transaction advances the virtual clock (see Arduino.h) by the time it would take on the
+	wire at the begin() rate, 9 bits per byte plus the address byte.  host_timing_set(false) turns that
+	off.  The non-blocking calls (sendTransmission(), sendRequest()) complete immediately but report
+	not-done for host_latency_set() calls to done() so that callers' in-flight handling is exercised.
+***************************************************************************************************/
+
+#include <Arduino.h>
+
+#define I2C_T3_H										// as the real library does; code tests for it
+
+#define I2C_TX_BUFFER_LENGTH	259
+#define I2C_RX_BUFFER_LENGTH	259
+
+enum i2c_mode	{I2C_MASTER, I2C_SLAVE};
+enum i2c_pullup	{I2C_PULLUP_EXT, I2C_PULLUP_INT};
+enum i2c_rate	{I2C_RATE_100 = 100, I2C_RATE_200 = 200, I2C_RATE_300 = 300, I2C_RATE_400 = 400,
+				I2C_RATE_600 = 600, I2C_RATE_800 = 800, I2C_RATE_1000 = 1000};	// values are kHz; not so in i2c_t3
+enum i2c_pins	{I2C_PINS_16_17, I2C_PINS_18_19, I2C_PINS_29_30, I2C_PINS_26_31, I2C_PINS_33_34,
+				I2C_PINS_37_38, I2C_PINS_3_4, I2C_PINS_7_8};
+enum i2c_stop	{I2C_NOSTOP, I2C_STOP};
+enum i2c_op_mode	{I2C_OP_MODE_IMM, I2C_OP_MODE_ISR, I2C_OP_MODE_DMA};
+enum i2c_status	{I2C_WAITING, I2C_TIMEOUT, I2C_ADDR_NAK, I2C_DATA_NAK, I2C_ARB_LOST, I2C_BUF_OVF,
+				I2C_NOT_ACQ, I2C_DMA_ERR, I2C_SENDING, I2C_SEND_ADDR, I2C_RECEIVING, I2C_SLAVE_TX, I2C_SLAVE_RX};
+
+
+//---------------------------< I 2 C _ T 3 _ H O S T _ D E V I C E >------------------------------------------
+//
+// A simulated slave.  host_write() gets the bytes the master wrote (not the address); host_read() fills count
+// bytes for the master to read and may reduce count.  Both return I2C_WAITING for success or the i2c_status the
+// master should see (I2C_DATA_NAK, I2C_TIMEOUT, ...).
+//
+
+class i2c_t3_host_device
+	{
+	public:
+		virtual				~i2c_t3_host_device () {}
+		virtual i2c_status	host_write (const uint8_t* data, size_t count, bool stop) = 0;
+		virtual i2c_status	host_read (uint8_t* data, size_t& count) = 0;
+	};
+
+
+struct i2c_t3_host_bus									// one per bus; shared by all i2c_t3 objects for that bus
+	{
+	i2c_t3_host_device*	device[128];
+	uint8_t		tx_addr;
+	uint8_t		tx_buf[I2C_TX_BUFFER_LENGTH];
+	size_t		tx_count;
+	uint8_t		rx_buf[I2C_RX_BUFFER_LENGTH];
+	size_t		rx_count;
+	size_t		rx_index;
+	i2c_status	current_status;						// what status() returns once the transaction is done
+	uint32_t	pending_polls;						// done() calls left before the transaction is done
+	uint32_t	latency_polls;						// see host_latency_set()
+	uint32_t	rate_khz;
+	i2c_op_mode	op_mode;							// recorded only; every mode behaves the same here
+	bool		timing;								// advance the virtual clock by wire time
+	uint32_t	reset_count;
+	uint64_t	transaction_count;					// host only statistics
+	uint64_t	byte_count;
+	};
+
+
+class i2c_t3
+	{
+	public:
+							i2c_t3 (uint8_t bus_num);
+
+		void				begin (i2c_mode mode, uint8_t address, i2c_pins pins, i2c_pullup pullup, i2c_rate rate);
+		void				setDefaultTimeout (uint32_t timeout) {_default_timeout = timeout;}
+		void				setRate (i2c_rate rate) {_bus->rate_khz = rate;}
+		uint8_t				setOpMode (i2c_op_mode mode) {_bus->op_mode = mode; return 1;}
+
+		void				beginTransmission (uint8_t address);
+		size_t				write (uint8_t data);
+		size_t				write (const uint8_t* data, size_t count);
+		uint8_t				endTransmission (i2c_stop send_stop=I2C_STOP);
+		uint8_t				endTransmission (i2c_stop send_stop, uint32_t timeout);
+		void				sendTransmission (i2c_stop send_stop=I2C_STOP);
+
+		size_t				requestFrom (uint8_t address, size_t count, i2c_stop send_stop=I2C_STOP);
+		size_t				requestFrom (uint8_t address, size_t count, i2c_stop send_stop, uint32_t timeout);
+		void				sendRequest (uint8_t address, size_t count, i2c_stop send_stop=I2C_STOP);
+
+		uint8_t				done (void);
+		uint8_t				finish (uint32_t timeout=0);
+		i2c_status			status (void);
+		uint8_t				getError (void);
+
+		int					available (void);
+		uint8_t				readByte (void);
+		int					read (void);
+		int					peek (void);
+
+		void				resetBus (void);
+		uint32_t			resetBusCountRead (void) {return _bus->reset_count;}
+
+		// host only
+		void				host_attach (uint8_t address, i2c_t3_host_device* device);
+		void				host_detach (uint8_t address);
+		void				host_latency_set (uint32_t polls) {_bus->latency_polls = polls;}
+		void				host_timing_set (bool timing) {_bus->timing = timing;}
+		i2c_t3_host_bus*	host_bus (void) {return _bus;}
+
+	private:
+		i2c_t3_host_bus*	_bus;
+		uint32_t			_default_timeout = 0;
+
+		void				deliver_write (i2c_stop send_stop);
+		void				deliver_read (uint8_t address, size_t count, i2c_stop send_stop);
+		void				wire_time (size_t count);
+	};
+
+extern i2c_t3 Wire;
+extern i2c_t3 Wire1;
+
+#endif /* HOST_I2C_T3_H */
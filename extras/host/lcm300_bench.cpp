@@ -0,0 +1,433 @@
+/** ---------- LCM300 host benchmarks ------------------------
+
+Times the decode and EOUT hot paths and a full telemetry sweep against simulated supplies. One JSON
+object per line on stdout so that results can be collected and compared from run to run:
+
+	{"bench":"<name>","ops":<n>,"ns_per_op":<ns>,"checksum":<x>, ...}
+
+checksum is a function of every result so the compiler can't discard the work; it should not change
+unless decoding changes.  mismatch and wrong count results that are not what they must be; any at all
+is printed to stderr and makes the exit status 1 (make check).
+
+	make bench
+	build/lcm300_bench [repeat]
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		streaming statistics
+2026 Oct 16		exit status 1 on any mismatched or wrong result
+2026 Oct 16		integer milli decoders checked against a double reference
+
+--------------------------------**/
+
+#include <Arduino.h>
+#include <Systronix_LCM300_bus.h>
+#include <Systronix_LCM300_sim.h>
+#include <Systronix_LCM300_metrics.h>
+#include <chrono>
+
+#define		SIM_COUNT		LCM300_BUS_MAX_DEVICES
+
+static Systronix_LCM300_sim	sim[SIM_COUNT];
+static Systronix_LCM300		supply[SIM_COUNT];
+static Systronix_LCM300_bus	bus;
+
+static uint32_t	repeat = 100;									// passes over the 16-bit domain
+static uint32_t	fail_count;										// benchmarks with wrong results
+
+
+//---------------------------< N O W _ N S >------------------------------------------------------------------
+//
+// real time, not the virtual clock
+//
+
+static uint64_t now_ns (void)
+	{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+
+//---------------------------< R E P O R T >------------------------------------------------------------------
+
+static void report (const char* name, uint64_t ops, uint64_t ns, double checksum, const char* extra = "")
+	{
+	printf ("{\"bench\":\"%s\",\"ops\":%llu,\"ns_per_op\":%.3f,\"checksum\":%.6g%s}\n",
+		name, (unsigned long long)ops, (double)ns / ops, checksum, extra);
+	fflush (stdout);
+	}
+
+
+//---------------------------< C H E C K >--------------------------------------------------------------------
+
+static void check (uint64_t wrong, const char* name)
+	{
+	if (!wrong)
+		return;
+	fail_count++;
+	fprintf (stderr, "lcm300_bench: %s: %llu wrong results\n", name, (unsigned long long)wrong);
+	}
+
+
+//---------------------------< M I L L I _ E X P E C T >------------------------------------------------------
+//
+// What the integer decoders must return for mantissa * 2^exponent: * 1000, rounded half up, saturated to int32_t.
+// Worked in double, where every one of these is exact.
+//
+
+static int32_t milli_expect (int32_t mantissa, int8_t exponent)
+	{
+	double	milli = floor (ldexp ((double)mantissa * 1000, exponent) + 0.5);
+
+	if (INT32_MAX < milli)
+		return INT32_MAX;
+	if (INT32_MIN > milli)
+		return INT32_MIN;
+	return (int32_t)milli;
+	}
+
+
+//---------------------------< B E N C H _ D E C O D E >------------------------------------------------------
+//
+// every 16-bit input, repeat times; the integer decoders are checked against milli_expect() for every input
+//
+
+static void bench_decode (void)
+	{
+	Systronix_LCM300&	dev = supply[0];
+	uint64_t	start;
+	double		sum;
+	uint32_t	pass;
+	uint32_t	raw;
+	float		acc;
+	int8_t		exponent = dev.identity_get().vout_mode & 0x10 ? (int8_t)(dev.identity_get().vout_mode | 0xE0) : dev.identity_get().vout_mode;
+	uint64_t	elapsed;
+	uint64_t	wrong;
+	char		extra[48];
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		acc = 0;
+		for (raw=0; raw<=0xFFFF; raw++)
+			acc += dev.raw_voltage_to_float ((uint16_t)raw);
+		sum += acc;
+		}
+	report ("raw_voltage_to_float", (uint64_t)repeat << 16, now_ns() - start, sum);
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		acc = 0;
+		for (raw=0; raw<=0xFFFF; raw++)
+			acc += dev.pmbus_literal_to_float ((uint16_t)raw);
+		sum += acc;
+		}
+	report ("pmbus_literal_to_float", (uint64_t)repeat << 16, now_ns() - start, sum);
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		int64_t	isum = 0;
+		for (raw=0; raw<=0xFFFF; raw++)
+			isum += dev.raw_voltage_to_milli ((uint16_t)raw);
+		sum += isum;
+		}
+	elapsed = now_ns() - start;
+	wrong = 0;
+	for (raw=0; raw<=0xFFFF; raw++)
+		{
+		if (dev.raw_voltage_to_milli ((uint16_t)raw) != milli_expect (raw, exponent))
+			wrong++;
+		}
+	snprintf (extra, sizeof(extra), ",\"wrong\":%llu", (unsigned long long)wrong);
+	report ("raw_voltage_to_milli", (uint64_t)repeat << 16, elapsed, sum, extra);
+	check (wrong, "raw_voltage_to_milli");
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		int64_t	isum = 0;
+		for (raw=0; raw<=0xFFFF; raw++)
+			isum += dev.pmbus_literal_to_milli ((uint16_t)raw);
+		sum += isum;
+		}
+	elapsed = now_ns() - start;
+	wrong = 0;
+	for (raw=0; raw<=0xFFFF; raw++)
+		{
+		if (dev.pmbus_literal_to_milli ((uint16_t)raw) != milli_expect ((int16_t)(raw << 5) >> 5, (int16_t)raw >> 11))
+			wrong++;
+		}
+	if (-1024000 != dev.pmbus_literal_to_milli (0x57FF))	// -1 * 2^10: negative mantissa, positive exponent
+		wrong++;
+	snprintf (extra, sizeof(extra), ",\"wrong\":%llu", (unsigned long long)wrong);
+	report ("pmbus_literal_to_milli", (uint64_t)repeat << 16, elapsed, sum, extra);
+	check (wrong, "pmbus_literal_to_milli");
+	}
+
+
+//---------------------------< B E N C H _ B A T C H >--------------------------------------------------------
+//
+// decode_linear11() and decode_linear16() over every 16-bit input, and how many results differ in any bit from
+// the scalar functions
+//
+
+static void bench_batch (void)
+	{
+	static uint16_t	raw[0x10000];
+	static float	value[0x10000];
+	Systronix_LCM300&	dev = supply[0];
+	int8_t		exponent = dev.identity_get().vout_mode & 0x10 ? (int8_t)(dev.identity_get().vout_mode | 0xE0) : dev.identity_get().vout_mode;
+	uint64_t	start;
+	uint64_t	mismatch;
+	double		sum;
+	uint32_t	pass;
+	uint32_t	i;
+	char		extra[48];
+
+	for (i=0; i<=0xFFFF; i++)
+		raw[i] = (uint16_t)i;
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		Systronix_LCM300::decode_linear11 (raw, value, 0x10000);
+		sum += value[pass & 0xFFFF];
+		}
+	mismatch = 0;
+	for (i=0; i<=0xFFFF; i++)
+		{
+		float	scalar = dev.pmbus_literal_to_float (raw[i]);
+		if (memcmp (&scalar, &value[i], sizeof(float)))
+			mismatch++;
+		}
+	snprintf (extra, sizeof(extra), ",\"mismatch\":%llu", (unsigned long long)mismatch);
+	report ("decode_linear11", (uint64_t)repeat << 16, now_ns() - start, sum, extra);
+	check (mismatch, "decode_linear11");
+
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		Systronix_LCM300::decode_linear16 (raw, value, 0x10000, exponent);
+		sum += value[pass & 0xFFFF];
+		}
+	mismatch = 0;
+	for (i=0; i<=0xFFFF; i++)
+		{
+		float	scalar = dev.raw_voltage_to_float (raw[i]);
+		if (memcmp (&scalar, &value[i], sizeof(float)))
+			mismatch++;
+		}
+	snprintf (extra, sizeof(extra), ",\"mismatch\":%llu", (unsigned long long)mismatch);
+	report ("decode_linear16", (uint64_t)repeat << 16, now_ns() - start, sum, extra);
+	check (mismatch, "decode_linear16");
+	}
+
+
+//---------------------------< B E N C H _ E O U T >----------------------------------------------------------
+//
+// A long synthetic READ_EOUT sequence: power wandering 0 - 300W, 100 - 2000 samples between reads, so that the
+// accumulator and rollover counter wrap often and the sample counter wraps now and then.  Frames are built ahead
+// of time; only pmbus_average_power() / eout_power_bulk() is timed.  Reports how many results were off by more
+// than a watt.
+//
+
+static void bench_eout (void)
+	{
+	const uint32_t	frames = 1 << 16;
+	static uint8_t	frame[1 << 16][EOUT];
+	static uint16_t	truth[1 << 16];
+	Systronix_LCM300&	dev = supply[0];
+	uint64_t	energy = 0;
+	uint64_t	samples = 0;
+	uint32_t	seed = 12345;
+	uint32_t	delta;
+	uint32_t	watts = 150;
+	uint32_t	i;
+	uint32_t	pass;
+	uint64_t	start;
+	uint64_t	elapsed = 0;
+	uint64_t	wrong = 0;
+	double		sum = 0;
+	char		extra[64];
+
+	for (i=0; i<frames; i++)
+		{
+		seed = seed * 1103515245 + 12345;
+		delta = 100 + (seed >> 16) % 1900;
+		watts = (watts + (seed >> 8) % 21 + 290) % 301;		// random walk 0..300
+		samples += delta;
+		energy += (uint64_t)delta * watts;
+		truth[i] = watts;
+
+		frame[i][0] = EOUT - 1;
+		frame[i][1] = (uint8_t)(energy % 32767);
+		frame[i][2] = (uint8_t)((energy % 32767) >> 8);
+		frame[i][3] = (uint8_t)(energy / 32767);
+		frame[i][4] = (uint8_t)samples;
+		frame[i][5] = (uint8_t)(samples >> 8);
+		frame[i][6] = (uint8_t)(samples >> 16);
+		}
+
+	for (pass=0; pass<repeat; pass++)
+		{
+		memset (&dev.eout_data, 0, sizeof(dev.eout_data));			// the state before frame[0]: all counters 0
+		start = now_ns();
+		for (i=0; i<frames; i++)
+			{
+			memcpy (dev.cmd_response.as_array, frame[i], EOUT);
+			dev.pmbus_average_power ();
+			sum += dev.eout_data.average_power;
+			if (0 == pass && (1 < (int32_t)(dev.eout_data.average_power - truth[i]) || -1 > (int32_t)(dev.eout_data.average_power - truth[i])))
+				wrong++;
+			}
+		elapsed += now_ns() - start;
+		}
+
+	snprintf (extra, sizeof(extra), ",\"wrong\":%llu", (unsigned long long)wrong);
+	report ("pmbus_average_power", (uint64_t)repeat * frames, elapsed, sum, extra);
+	check (wrong, "pmbus_average_power");
+
+	static uint8_t	packed[1 + (1 << 16)][EOUT];				// frame[] after an all-zero frame, for frame[0]'s predecessor
+	static float	power[1 << 16];
+	memset (packed[0], 0, EOUT);
+	packed[0][0] = EOUT - 1;
+	memcpy (packed[1], frame, sizeof(frame));
+	wrong = 0;
+	sum = 0;
+	start = now_ns();
+	for (pass=0; pass<repeat; pass++)
+		{
+		Systronix_LCM300::eout_power_bulk (packed[0], frames + 1, power);
+		sum += power[pass % frames];
+		}
+	elapsed = now_ns() - start;
+	for (i=0; i<frames; i++)
+		{
+		sum += power[i];
+		if (1.0 < fabs (power[i] - truth[i]))
+			wrong++;
+		}
+	snprintf (extra, sizeof(extra), ",\"wrong\":%llu", (unsigned long long)wrong);
+	report ("eout_power_bulk", (uint64_t)repeat * frames, elapsed, sum, extra);
+	check (wrong, "eout_power_bulk");
+	}
+
+
+//---------------------------< B E N C H _ S W E E P >--------------------------------------------------------
+//
+// Telemetry sweeps of eight simulated supplies through Systronix_LCM300_bus.  sweep_interval0: communication
+// interval set to 0 so this is all CPU: scheduling, transaction state machine, decode.  sweep_bus_time: default
+// interval, reports the simulated bus time per sweep, which is what it costs on a real shelf.
+//
+
+static void bench_sweep (void)
+	{
+	uint32_t	sweeps = repeat * 20;
+	uint32_t	i;
+	uint64_t	start;
+	uint64_t	virtual_start;
+	uint64_t	transactions;
+	double		sum = 0;
+	char		extra[96];
+
+	for (i=0; i<SIM_COUNT; i++)
+		{
+		supply[i].interval_set (0);
+		supply[i].telemetry_set (LCM300_TELEMETRY_DEFAULT, 0);
+		}
+
+	transactions = Wire1.host_bus()->transaction_count;
+	start = now_ns();
+	for (i=0; i<sweeps; i++)
+		{
+		bus.poll_telemetry ();
+		bus.run ();
+		sum += supply[i % SIM_COUNT].snapshot().vout;
+		}
+	transactions = Wire1.host_bus()->transaction_count - transactions;
+	snprintf (extra, sizeof(extra), ",\"supplies\":%d,\"transactions\":%llu,\"ns_per_transaction\":%.1f",
+		SIM_COUNT, (unsigned long long)transactions, (double)(now_ns() - start) / transactions);
+	report ("sweep_interval0", sweeps, now_ns() - start, sum, extra);
+
+	for (i=0; i<SIM_COUNT; i++)
+		supply[i].interval_set (LCM300_CMD_INTERVAL_US);
+
+	sweeps = 10;
+	start = now_ns();
+	virtual_start = host_clock_get();
+	for (i=0; i<sweeps; i++)
+		{
+		bus.poll_telemetry ();
+		bus.run ();
+		sum += supply[i % SIM_COUNT].snapshot().iout;
+		}
+	snprintf (extra, sizeof(extra), ",\"supplies\":%d,\"bus_ms_per_sweep\":%.2f",
+		SIM_COUNT, (host_clock_get() - virtual_start) / 1000.0 / sweeps);
+	report ("sweep_bus_time", sweeps, now_ns() - start, sum, extra);
+	}
+
+
+//---------------------------< B E N C H _ M E T R I C S >----------------------------------------------------
+//
+// Systronix_LCM300_metrics::sample(): one metric, all three windows, two quantiles and the EWMA per sample, at
+// 20 samples per second of virtual time so windows roll as they would.  checksum is the median and p95 of the
+// last complete minute.
+//
+
+static void bench_metrics (void)
+	{
+	static Systronix_LCM300_metrics	metrics;
+	uint32_t	samples = repeat * 100000;
+	uint32_t	ms = millis();
+	uint32_t	i;
+	uint64_t	start;
+	float		value;
+
+	metrics.begin (supply[0]);
+	start = now_ns();
+	for (i=0; i<samples; i++)
+		{
+		value = 24.0f + (float)((i * 2654435761u) >> 22) / 10240;		// 24 - 24.1V, scrambled
+		metrics.sample (Systronix_LCM300_metrics::VOUT, value, ms + i * 50);
+		}
+	const Systronix_LCM300_metrics::summary_t&	s = metrics.last (Systronix_LCM300_metrics::VOUT, Systronix_LCM300_metrics::MINUTE);
+	report ("metrics_sample", samples, now_ns() - start, s.quantile[0] + s.quantile[1]);
+	}
+
+
+//---------------------------< M A I N >----------------------------------------------------------------------
+
+int main (int argc, char** argv)
+	{
+	uint8_t	i;
+
+	if (1 < argc)
+		repeat = strtoul (argv[1], NULL, 0);
+
+	Serial.quiet (true);
+	for (i=0; i<SIM_COUNT; i++)
+		{
+		sim[i].attach (Wire1, LCM300_BASE_MIN + i);
+		supply[i].setup (LCM300_BASE_MIN + i, Wire1, (char*)"Wire1");
+		supply[i].begin (I2C_PINS_29_30);
+		supply[i].init ();
+		bus.add (supply[i]);
+		}
+
+	bench_decode ();
+	bench_batch ();
+	bench_eout ();
+	bench_sweep ();
+	bench_metrics ();
+	return fail_count ? 1 : 0;
+	}
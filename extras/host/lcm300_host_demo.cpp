@@ -0,0 +1,636 @@
+/** ---------- LCM300 host demo ------------------------
+
+Runs the library on a Linux host against simulated supplies: reads identity and telemetry, times a
+sweep of one supply and of four on one bus (in simulated time), and injects some faults.  Along the way
+it checks what the results must be (supplies found, energy against the power the simulator delivered,
+fault events, recovery); each check that fails is printed to stderr and the exit status is 1.
+
+	make run
+	make check		this, the benchmarks and the replay, failing on any wrong result
+
+The trace and the binary log go in the directory given as the one argument, build when there is none.
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		energy meter
+2026 Oct 16		response buffers
+2026 Oct 16		streaming
+2026 Oct 16		binary log
+2026 Oct 16		fault monitor
+2026 Oct 16		second net on the host transport
+2026 Oct 16		streaming statistics
+2026 Oct 16		bus trace of Wire1 for lcm300_replay
+2026 Oct 16		startup by discover(); time to first telemetry against init() per address
+2026 Oct 16		energy from frames processed later, against the live meter
+2026 Oct 16		discover() registers the empty slots; 0x5C found by background re-probe
+2026 Oct 16		expected replay results beside the trace
+2026 Oct 16		checks with a nonzero exit status for make check
+2026 Oct 16		0x5A comes back with a longer MFR_REVISION
+2026 Oct 16		deferred energy processed by another instance, Pout changing after the gap
+2026 Oct 16		stream restarted with samples still in the ring; no last sample printed when none were drained
+2026 Oct 16		stats printed only when the library is instrumented
+2026 Oct 16		stats and 0x5B's schedules kept here and attached to the supplies
+2026 Oct 16		trace and log written to the directory given, so make BUILD=... replays its own trace
+
+--------------------------------**/
+
+#include <Arduino.h>
+#include <Systronix_LCM300_bus.h>
+#include <Systronix_LCM300_stream.h>
+#include <Systronix_LCM300_log.h>
+#include <Systronix_LCM300_metrics.h>
+#include <Systronix_LCM300_sim.h>
+#include <Systronix_LCM300_host_transport.h>
+#include <Systronix_LCM300_trace.h>
+
+#define		SIM_COUNT		4
+
+Systronix_LCM300_sim	sim[SIM_COUNT];						// at 0x58 - 0x5B
+Systronix_LCM300		supply[LCM300_BUS_MAX_DEVICES];		// one for each possible address
+Systronix_LCM300_bus	bus;
+Systronix_LCM300::stats_t	supply_stats[LCM300_BUS_MAX_DEVICES];	// the supplies' own bookkeeping, kept here
+Systronix_LCM300::schedule_t	schedule_slots[LCM300_SCHEDULE_SLOTS];	// 0x5B's adaptive schedules
+Systronix_LCM300_stream	stream;
+Systronix_LCM300_log	lcm_log;
+Systronix_LCM300_recorder	recorder (Systronix_LCM300_i2c_t3::shared (Wire1));	// everything on Wire1, to the trace file
+FILE*					trace_file;
+uint32_t				trace_start_ms;						// millis() at trace time 0
+uint32_t				check_count;
+uint32_t				check_fail_count;
+
+
+//---------------------------< C H E C K >--------------------------------------------------------------------
+//
+// A result the demo relies on; main() exits 1 when any is wrong
+//
+
+void check (bool ok, const char* what)
+	{
+	check_count++;
+	if (ok)
+		return;
+	check_fail_count++;
+	fprintf (stderr, "lcm300_host_demo: check failed: %s\n", what);
+	}
+
+
+//---------------------------< P R I N T _ T E L E M E T R Y >------------------------------------------------
+
+void print_telemetry (Systronix_LCM300& dev)
+	{
+	const Systronix_LCM300::telemetry_t&	t = dev.snapshot();
+
+	Serial.printf ("0x%.2X: %.2fV %.2fA %.1fW %.1fC %urpm status 0x%.4X\n", dev.base_get(),
+		t.vout, t.iout, t.pout, t.temperature_2, t.fan_speed, t.status_word);
+	}
+
+
+//---------------------------< F A U L T _ E V E N T >--------------------------------------------------------
+
+void fault_event (Systronix_LCM300* dev, uint16_t fault, bool asserted)
+	{
+	Serial.printf ("0x%.2X: %8ums %s %s\n", dev->base_get(), millis(), Systronix_LCM300::fault_name (fault), asserted ? "set" : "clear");
+	}
+
+
+//---------------------------< T R A C E _ S I N K >----------------------------------------------------------
+
+void trace_sink (const uint8_t* record, size_t count)
+	{
+	fwrite (record, 1, count, trace_file);
+	}
+
+
+//---------------------------< E X P E C T _ W R I T E >------------------------------------------------------
+//
+// What lcm300_replay must end up with for each Wire1 supply, beside the trace: one line per address of the
+// decoded telemetry, when VOUT was last read (in trace time), and the energy meter.  Format in lcm300_replay.cpp.
+//
+
+void expect_write (const char* name)
+	{
+	FILE*		out = fopen (name, "w");
+	uint8_t		i;
+
+	if (!out)
+		return;
+	for (i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		const Systronix_LCM300::telemetry_t&	t = supply[i].snapshot();
+		const Systronix_LCM300::energy_t&		e = supply[i].energy;
+		uint32_t	vout_ms = t.read_ms[Systronix_LCM300::TELEM_VOUT];
+
+		fprintf (out, "0x%.2X %.9g %.9g %.9g %.9g %u 0x%.4X %u %llu %u %u\n", supply[i].base_get(), t.vout, t.iout, t.pout,
+			t.temperature_2, t.fan_speed, t.status_word, vout_ms ? vout_ms - trace_start_ms : 0,
+			(unsigned long long)e.energy_mws, e.intervals, e.ambiguous_count);
+		}
+	fclose (out);
+	}
+
+
+//---------------------------< B O O T _ S H E L F >----------------------------------------------------------
+//
+// A shelf of its own with five supplies in eight slots, from nothing to a first telemetry sweep of every supply
+// found: init() one address at a time as sketches always have, or Bus.discover().  Returns microseconds.
+//
+
+uint64_t boot_shelf (bool discover)
+	{
+	Systronix_LCM300_host_transport	shelf;
+	Systronix_LCM300_sim	shelf_sim[5];
+	Systronix_LCM300		shelf_supply[LCM300_BUS_MAX_DEVICES];
+	Systronix_LCM300_bus	shelf_bus;
+	uint64_t	start;
+	uint8_t		i;
+
+	for (i=0; i<5; i++)
+		shelf_sim[i].attach (shelf, LCM300_BASE_MIN + ((i < 3) ? i : i + 2));	// 0x58 - 0x5A, 0x5D, 0x5E
+	for (i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		shelf_supply[i].setup (LCM300_BASE_MIN + i, shelf, (char*)"shelf");
+		shelf_supply[i].begin (I2C_PINS_29_30);
+		}
+
+	start = host_clock_get();
+	if (discover)
+		shelf_bus.discover (shelf_supply, LCM300_BUS_MAX_DEVICES);
+	else
+		{
+		for (i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+			{
+			if (SUCCESS == shelf_supply[i].init())
+				shelf_bus.add (shelf_supply[i]);
+			}
+		}
+	shelf_bus.poll_telemetry ();
+	shelf_bus.run ();
+	return host_clock_get() - start;
+	}
+
+
+//---------------------------< E N E R G Y _ D E F E R R E D >------------------------------------------------
+//
+// A supply of its own reads a minute of Pout and READ_EOUT into response buffers, 300W with a 30s gap in the
+// middle, then 150W.  The frames, processed afterward into a meter of our own by a different instance (0x58,
+// 100W), must give the totals the driver's live meter got, and those must be the energy the simulator delivered
+// between the first and last reads: the gap estimated from the Pout read with the frame that ends it, not from
+// the Pout of whichever supply does the processing or from the Pout now.
+//
+
+void energy_deferred (void)
+	{
+	Systronix_LCM300_host_transport	net;
+	Systronix_LCM300_sim	net_sim;
+	Systronix_LCM300		dev;
+	Systronix_LCM300::response_t	frame[8];
+	Systronix_LCM300::response_t	pout[8];			// Pout read just before each frame
+	Systronix_LCM300::energy_t		meter = {};
+	double		first_ws = 0;
+	double		delivered_ws;
+	uint8_t		i;
+
+	net_sim.attach (net, LCM300_BASE_MIN);
+	net_sim.pout_set (300.0);
+	dev.setup (LCM300_BASE_MIN, net, (char*)"deferred");
+	dev.begin (I2C_PINS_29_30);
+	dev.init ();
+	for (i=0; i<8; i++)
+		{
+		delay ((4 == i) ? 30000 : 10000);
+		if (5 == i)
+			net_sim.pout_set (150.0);
+		if (SUCCESS == dev.command_start_into (READ_POUT_CMD, &pout[i]))	// the live meter's gap estimate uses it too
+			while (LCM300_PENDING == dev.command_poll());
+		if (SUCCESS == dev.command_start_into (READ_EOUT_CMD, &frame[i]))
+			while (LCM300_PENDING == dev.command_poll());
+		if (0 == i)
+			first_ws = net_sim.energy_ws();
+		}
+	delivered_ws = net_sim.energy_ws() - first_ws;
+
+	for (i=0; i<8; i++)									// later, elsewhere: the frames, in the order read
+		{
+		if (SUCCESS == frame[i].result)
+			supply[0].energy_update (meter, (const uint8_t*)frame[i].data.as_array, frame[i].ms,
+				(SUCCESS == pout[i].result) ? dev.pmbus_literal_to_float (pout[i].data.as_word) : -1);
+		}
+
+	Serial.printf ("deferred: %.3fWh over %u intervals, %u ambiguous, %.1fs; live %.3fWh over %u intervals, %u ambiguous, %.1fs;"
+		" delivered %.3fWh\n", meter.energy_mws / 3600000.0, meter.intervals, meter.ambiguous_count, meter.gap_ms / 1000.0,
+		dev.energy.energy_mws / 3600000.0, dev.energy.intervals, dev.energy.ambiguous_count, dev.energy.gap_ms / 1000.0,
+		delivered_ws / 3600.0);
+	check ((meter.energy_mws == dev.energy.energy_mws) && (meter.intervals == dev.energy.intervals) &&
+		(meter.ambiguous_count == dev.energy.ambiguous_count) && (meter.gap_ms == dev.energy.gap_ms) &&
+		(meter.gap_estimate_mws == dev.energy.gap_estimate_mws), "deferred energy totals, by another instance, are the live meter's");
+	check ((6 == meter.intervals) && (1 == meter.ambiguous_count), "deferred energy: six intervals, the 30s gap ambiguous");
+	check (0.01 > fabs ((meter.energy_mws + meter.gap_estimate_mws) / 1000.0 - delivered_ws) / delivered_ws,
+		"energy meter within 1% of the energy delivered, the gap at the Pout of its own supply");
+	}
+
+
+//---------------------------< O U T _ P A T H >--------------------------------------------------------------
+
+const char*		out_dir = "build";
+
+const char* out_path (const char* name)
+	{
+	static char	path[256];
+
+	snprintf (path, sizeof(path), "%s/%s", out_dir, name);
+	return path;
+	}
+
+
+//---------------------------< M A I N >----------------------------------------------------------------------
+
+int main (int argc, char** argv)
+	{
+	uint64_t	start;
+	uint8_t		i;
+
+	if (1 < argc)
+		out_dir = argv[1];
+
+	uint8_t		trace_header[LCM300_TRACE_HEADER_SIZE];
+	trace_file = fopen (out_path ("lcm300_demo.lcmtrace"), "wb");	// make replay plays it back
+	if (trace_file)
+		{
+		fwrite (trace_header, 1, recorder.header (trace_header), trace_file);
+		host_clock_advance (1000 - host_clock_get() % 1000);	// trace time 0 on a whole millisecond, as lcm300_replay has it
+		trace_start_ms = host_clock_get() / 1000;
+		recorder.begin (trace_sink);
+		}
+
+	for (i=0; i<SIM_COUNT; i++)
+		{
+		sim[i].attach (Wire1, LCM300_BASE_MIN + i);
+		sim[i].pout_set (100.0 + 25 * i);
+		}
+
+	// startup: probe all eight addresses, then read VOUT_MODE and identity of the supplies found, interleaved
+	for (i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		supply[i].setup (LCM300_BASE_MIN + i, recorder, (char*)"Wire1");
+		supply[i].begin (I2C_PINS_29_30);
+		supply[i].stats_attach (&supply_stats[i]);
+		}
+	start = host_clock_get();
+	i = bus.discover (supply, LCM300_BUS_MAX_DEVICES);
+	Serial.printf ("discover: %u supplies ready in %.1fms:", i, (host_clock_get() - start) / 1000.0);
+	check (SIM_COUNT == i, "discover() readies the four simulated supplies");
+	for (i=0; i<LCM300_BUS_MAX_DEVICES; i++)
+		{
+		Serial.printf (" 0x%.2X %s", supply[i].base_get(), supply[i].error.exists ? "present" : "absent");
+		check ((i < SIM_COUNT) == supply[i].error.exists, "discover(): 0x58 - 0x5B present, the empty slots absent");
+		}
+	check (LCM300_BUS_MAX_DEVICES == bus.count(), "discover() registers every slot");
+
+	uint64_t	init_us = boot_shelf (false);
+	uint64_t	discover_us = boot_shelf (true);
+	Serial.printf ("\nshelf of 5 in 8 slots, to first telemetry: init() per address %.1fms, discover() %.1fms (%.1fx)\n",
+		init_us / 1000.0, discover_us / 1000.0, (double)init_us / discover_us);
+
+	const Systronix_LCM300::identity_t&	id = supply[0].identity_get();
+	Serial.printf ("\n%s %s rev %s, %s, %s serial %s; PMBus 0x%.2X; Vout %.2f-%.2fV, Iout max %.2fA\n\n",
+		id.mfr_id, id.mfr_model, id.mfr_revision, id.mfr_location, id.mfr_date, id.mfr_serial,
+		id.pmbus_revision, id.mfr_vout_min, id.mfr_vout_max, id.mfr_iout_max);
+
+	bus.stats_reset ();
+
+	// one supply on its own
+	start = host_clock_get();
+	while (SUCCESS != supply[0].poll_telemetry());
+	Serial.printf ("one supply, one sweep: %.1fms\n", (host_clock_get() - start) / 1000.0);
+	print_telemetry (supply[0]);
+
+	// all of them, interleaved
+	delay (LCM300_TELEMETRY_PERIOD_MS);
+	start = host_clock_get();
+	bus.poll_telemetry ();
+	bus.run ();
+	Serial.printf ("\n%u supplies, one sweep each: %.1fms\n", SIM_COUNT, (host_clock_get() - start) / 1000.0);
+	for (i=0; i<bus.count(); i++)
+		if (bus.device_get(i)->error.exists)
+			print_telemetry (*bus.device_get(i));
+
+	// READ_EOUT average power over 5 seconds
+	supply[0].command_read (READ_EOUT_CMD);
+	supply[0].pmbus_average_power ();
+	delay (5000);
+	supply[0].command_read (READ_EOUT_CMD);
+	supply[0].pmbus_average_power ();
+	Serial.printf ("\n0x58: average power %uW\n", supply[0].eout_data.average_power);
+
+	// energy meter: a minute of reads every 10s (accumulator rolls over many times), then one 30s gap that
+	// could hide an energy counter wrap at 450W
+	Systronix_LCM300::energy_store_t	store;
+	for (i=0; i<6; i++)
+		{
+		delay (10000);
+		supply[0].command_read (READ_EOUT_CMD);
+		}
+	delay (30000);
+	supply[0].command_read (READ_EOUT_CMD);
+	Systronix_LCM300	rebooted;							// what 0x58 would start from after a reboot; supply[0] carries on
+	supply[0].energy_save (&store);
+	rebooted.energy_restore (&store);
+	const Systronix_LCM300::energy_t&	e = rebooted.energy;
+	Serial.printf ("0x58: %.1fWh over %u intervals, %.0f samples/s; %u ambiguous, %.1fs, ~%.1fWh\n",
+		e.energy_mws / 3600000.0, e.intervals, e.sample_rate, e.ambiguous_count, e.gap_ms / 1000.0,
+		e.gap_estimate_mws / 3600000.0);
+	energy_deferred ();
+
+	// a blocking read and an async read into a buffer of our own don't clobber each other
+	Systronix_LCM300::response_t	iout;
+	supply[2].command_read (READ_VOUT_CMD);
+	supply[2].command_start_into (READ_IOUT_CMD, &iout);
+	while (LCM300_PENDING == supply[2].command_poll());
+	Serial.printf ("\n0x5A: Vout %.2fV (cmd_response), Iout %.2fA read at %ums (response_t)\n",
+		supply[2].raw_voltage_to_float (supply[2].cmd_response.as_word), supply[2].pmbus_literal_to_float (iout.data.as_word), iout.ms);
+
+	// typed reads: the value type comes from the command's cmd[].format
+	float			volts;
+	uint16_t		status;
+	const char*		model;
+	supply[2].read<READ_VOUT_CMD> (volts);
+	supply[2].read<STATUS_WORD_CMD> (status);
+	supply[2].read<MFR_MODEL_CMD> (model);
+	Serial.printf ("0x5A: read<>: Vout %.2fV, status 0x%.4X, model %s; %u bytes per supply\n", volts, status, model,
+		(uint32_t)sizeof(Systronix_LCM300));
+
+	// stream Vout and Iout from 0x5B for 5 seconds, as fast as the 50ms interval allows; drain every 250ms
+	// into a binary log: make csv converts it
+	lcm300_sample_t	samples[LCM300_STREAM_RING];
+	float			values[LCM300_STREAM_RING];
+	size_t			count = 0;
+	size_t			drained = 0;					// samples read from the ring so far
+	lcm300_sample_t	last = {};						// the most recent of them
+	float			last_value = 0;
+	uint64_t		drained_us = host_clock_get();
+	uint8_t			record[LCM300_LOG_RECORD_MAX];
+	FILE*			log_file = fopen (out_path ("lcm300_demo.lcmlog"), "wb");
+	if (log_file)
+		{
+		fwrite (record, 1, lcm_log.header (record), log_file);
+		fwrite (record, 1, lcm_log.sample (record, supply[3].base_get(), VOUT_MODE_CMD, supply[3].identity.vout_mode, micros()), log_file);
+		}
+	stream.begin (supply[3], CMD_MASK(READ_VOUT_CMD) | CMD_MASK(READ_IOUT_CMD));
+	start = host_clock_get();
+	while (5000000 > host_clock_get() - start)
+		{
+		stream.tick ();
+		if (250000 <= host_clock_get() - drained_us)
+			{
+			count = stream.read (samples, LCM300_STREAM_RING);
+			stream.decode (samples, values, count);
+			drained_us = host_clock_get();
+			drained += count;
+			if (count)
+				{
+				last = samples[count-1];
+				last_value = values[count-1];
+				}
+			for (i=0; log_file && i<count; i++)
+				fwrite (record, 1, lcm_log.stream_sample (record, supply[3].base_get(), samples[i]), log_file);
+			}
+		}
+	stream.stop ();
+	while (LCM300_PENDING == stream.tick());
+	Serial.printf ("\n0x5B: streamed %u samples at %.1f/s, %u overruns, %u failed",
+		stream.sample_count, stream.rate, stream.overrun_count, stream.fail_count);
+	if (drained)
+		Serial.printf ("; last %s %.2f", (READ_VOUT_CMD == last.cmd_idx) ? "Vout" : "Iout", last_value);
+	Serial.printf ("\n");
+	stream.tick ();
+	check ((SUCCESS == stream.begin (supply[3], CMD_MASK(READ_VOUT_CMD))) && (0 == stream.available()) &&
+		(0 == stream.read (samples, LCM300_STREAM_RING)), "stream begin() leaves nothing for read()");
+	stream.stop ();
+	while (LCM300_PENDING == stream.tick());
+	if (log_file)
+		{
+		fclose (log_file);
+		Serial.printf ("0x5B: %u samples logged in %u bytes\n", lcm_log.record_count, lcm_log.byte_count);
+		}
+
+	// fault monitor: STATUS_WORD every 100ms, details only on change; a latched Vout overvoltage on 0x5A is
+	// reported, its details read, then cleared by the auto clear policy
+	uint32_t	reads = sim[2].read_count;
+	supply[2].fault_monitor_set (100, LCM300_FAULT_CLEAR_AUTO, fault_event);
+	Serial.printf ("\n");
+	start = host_clock_get();
+	while (1000000 > host_clock_get() - start)
+		bus.poll_telemetry ();
+	sim[2].word_set (STATUS_WORD_CMD_VAL, 0x8020);		// VOUT, VOUT_OV_FAULT
+	sim[2].byte_set (STATUS_BYTE_CMD_VAL, 0x20);
+	sim[2].byte_set (STATUS_VOUT_CMD_VAL, 0x80);		// VOUT_OV_FAULT
+	while (3000000 > host_clock_get() - start)
+		bus.poll_telemetry ();
+	Serial.printf ("0x5A: %u reads in 3s; %u events, %u detail reads, %u CLEAR_FAULTS\n", sim[2].read_count - reads,
+		supply[2].faults.event_count, supply[2].faults.drill_count, sim[2].clear_faults_count);
+	check ((6 == supply[2].faults.event_count) && (1 == supply[2].faults.drill_count) && (1 == sim[2].clear_faults_count),
+		"fault monitor: six events, one detail read, one CLEAR_FAULTS");
+	supply[2].fault_monitor_set (0);
+
+	// adaptive schedule on 0x5B: 10s of steady load backs Iout off to 2s; then a load that changes every 500ms and
+	// sits near MFR_IOUT_MAX speeds it back up
+	const Systronix_LCM300::schedule_t*	sched;
+	check ((SUCCESS != supply[3].schedule_default ()) && (SUCCESS != supply[3].schedule_set (READ_IOUT_CMD, 100, 2000)),
+		"no schedules without schedule_attach()");
+	supply[3].schedule_attach (schedule_slots, LCM300_SCHEDULE_SLOTS);
+	supply[3].schedule_default ();
+	sched = supply[3].schedule_get (READ_IOUT_CMD);
+	reads = sim[3].read_count;
+	start = host_clock_get();
+	while (10000000 > host_clock_get() - start)
+		bus.poll_telemetry ();
+	Serial.printf ("\n0x5B: steady: %u reads in 10s; Iout every %ums, temperature every %ums\n", sim[3].read_count - reads,
+		sched->period_ms, supply[3].schedule_get (READ_TEMPERATURE_2_CMD)->period_ms);
+	reads = sim[3].read_count;
+	for (i=0; i<20; i++)
+		{
+		sim[3].linear11_set (READ_IOUT_CMD_VAL, 12.0 + (i & 3) * 0.5);
+		start = host_clock_get();
+		while (500000 > host_clock_get() - start)
+			bus.poll_telemetry ();
+		}
+	Serial.printf ("0x5B: changing: %u reads in 10s; Iout every %ums, %u reads, %u sped up, %u backed off, %u missed, worst %ums late\n",
+		sim[3].read_count - reads, sched->period_ms, sched->read_count, sched->speedup_count, sched->backoff_count,
+		sched->miss_count, sched->late_max_ms);
+	supply[3].schedule_attach (NULL, 0);
+	supply[3].telemetry_set (LCM300_TELEMETRY_DEFAULT, LCM300_TELEMETRY_PERIOD_MS);
+
+	// write path on 0x58: the supply comes up write protected and ignores VOUT_COMMAND, which only the read back
+	// shows; unprotect, then trim READ_VOUT to 24.00V in closed loop against the sense offset
+	const Systronix_LCM300::output_t&	out = supply[0].output;
+	float	vout;
+	uint8_t	result = supply[0].vout_set (24.5);
+	Serial.printf ("\n0x58: vout_set protected: %s, %u verify failures\n", (SUCCESS == result) ? "SUCCESS" : "FAIL",
+		out.verify_fail_count);
+	supply[0].write_protect_set (LCM300_WP_ENABLE_OPER_PAGE_ONOFF_VOUT);
+	supply[0].command_read (STATUS_WORD_CMD);			// CML from the ignored write
+	supply[0].clear_faults_cmd ();
+	start = host_clock_get();
+	for (i=0; i<5; i++)
+		{
+		supply[0].command_read (READ_VOUT_CMD);
+		vout = supply[0].raw_voltage_to_float (supply[0].cmd_response.as_word);
+		if (0.002 > fabsf (24.0 - vout))
+			break;
+		supply[0].vout_set (out.vout_command + (24.0 - vout));
+		}
+	Serial.printf ("0x58: trimmed to %.3fV in %u steps, %.1fms; VOUT_COMMAND %.3fV\n", vout, i,
+		(host_clock_get() - start) / 1000.0, out.vout_command);
+	supply[0].vout_set (30.0);
+	Serial.printf ("0x58: vout_set (30.0) clamped to %.2fV; %u clamped\n", out.vout_command, out.clamp_count);
+
+	// margin test across the rack: all the writes, then all the read backs
+	for (i=0; i<SIM_COUNT; i++)
+		supply[i].write_protect_set (LCM300_WP_ENABLE_OPER_PAGE_ONOFF_VOUT);
+	bus.vout_set (24.0);
+	start = host_clock_get();
+	result = bus.margin_set (1);
+	Serial.printf ("%u supplies margin high: %s in %.1fms;", SIM_COUNT, (SUCCESS == result) ? "SUCCESS" : "FAIL",
+		(host_clock_get() - start) / 1000.0);
+	check (SUCCESS == result, "rack margin high verified on every present supply");
+	for (i=0; i<SIM_COUNT; i++)
+		{
+		supply[i].command_read (READ_VOUT_CMD);
+		Serial.printf (" %.2fV", supply[i].raw_voltage_to_float (supply[i].cmd_response.as_word));
+		}
+	bus.margin_set (0);
+	supply[0].write_protect_set (LCM300_WP_DISABLE_ALL);
+	result = supply[0].margin_set (-1);
+	Serial.printf ("\n0x58: margin low while protected: %s, %u refused without bus traffic\n",
+		(SUCCESS == result) ? "SUCCESS" : "FAIL", out.protect_count);
+
+	// recovery: 0x5A pulled for 3s then put back as a later revision with a longer MFR_REVISION string, a supply
+	// plugged into the empty slot at 0x5C, 0x59's bus held for three transactions; telemetry polling of the others
+	// carries on throughout
+	Systronix_LCM300_sim	spare;
+	uint64_t	back_us = 0;
+	sim[2].detach (Wire1);
+	sim[1].timeout_next (3);
+	start = host_clock_get();
+	while (3000000 > host_clock_get() - start)
+		bus.poll_telemetry ();
+	sim[2].string_set (MFR_REVISION_CMD_VAL, "0B1");
+	sim[2].attach (Wire1, LCM300_BASE_MIN + 2);
+	spare.attach (Wire1, LCM300_BASE_MIN + 4);
+	start = host_clock_get();
+	while (6000000 > host_clock_get() - start)
+		{
+		bus.poll_telemetry ();
+		if (!back_us && supply[2].error.exists)
+			back_us = host_clock_get() - start;
+		}
+	Serial.printf ("\n0x5A: %u retries, offline %u, back %.1fms after reinsertion (outage %ums, %u probes); identity %s\n",
+		supply[2].recovery.retry_count, supply[2].recovery.offline_count, back_us / 1000.0, supply[2].recovery.outage_ms,
+		supply[2].recovery.probe_count, supply[2].identity_valid() ? "reread" : "missing");
+	Serial.printf ("0x5C: %s after %u probes, Vout %.2fV; 0x59: %u stuck bus resets\n",
+		supply[4].error.exists ? "found" : "absent", supply[4].recovery.probe_count, supply[4].snapshot().vout,
+		supply[1].recovery.bus_reset_count);
+	check (supply[2].error.exists && supply[2].identity_valid() && (1 == supply[2].recovery.offline_count),
+		"0x5A back after reinsertion with its identity reread");
+	check ((0 == supply[2].pmbus_error.block_length_count) && !strcmp ("0B1", supply[2].identity_get().mfr_revision),
+		"0x5A's longer MFR_REVISION read at full length, not the old supply's");
+	check (supply[4].error.exists && (24.0 < supply[4].snapshot().vout), "0x5C plugged into an empty slot found and polled");
+	check (1 == supply[1].recovery.bus_reset_count, "0x59's held bus reset once");
+	bus.run ();											// finish the read in flight before using 0x59 directly
+
+	// faults
+	sim[1].nak_next (1);
+	sim[1].block_length_next (40);
+	supply[1].command_read (READ_VOUT_CMD);				// NAK
+	supply[1].command_read (MFR_MODEL_CMD);				// bogus length
+	supply[1].pec_set (true);
+	sim[1].pec_corrupt_next (1);
+	supply[1].command_read (READ_IOUT_CMD);				// bad PEC
+	supply[1].command_read (READ_IOUT_CMD);				// good PEC
+	Serial.printf ("\n0x59: %u good, %u errors, %u block length errors, %u PEC errors\n",
+		(uint32_t)supply[1].error.successful_count, (uint32_t)supply[1].error.total_error_count,
+		supply[1].pmbus_error.block_length_count, supply[1].pmbus_error.pec_count);
+	check ((1 == supply[1].pmbus_error.block_length_count) && (1 == supply[1].pmbus_error.pec_count),
+		"0x59: one bad block length and one bad PEC caught");
+
+#if LCM300_INSTRUMENTATION
+	// where the bus time went
+	const Systronix_LCM300::stats_t&	st = *supply[0].stats_get();
+	Serial.printf ("\n0x58: cmd    count fail  bytes  min/avg/max us\n");
+	for (i=0; i<CMD_ARRAY_SIZE; i++)
+		{
+		if (st.cmd[i].count)
+			Serial.printf ("      0x%.2X %6u %4u %6u  %u/%u/%u\n", supply[0].cmd[i].cmd_byte, st.cmd[i].count, st.cmd[i].fail_count,
+				st.cmd[i].bytes, st.cmd[i].latency_min_us, (uint32_t)(st.cmd[i].latency_sum_us / st.cmd[i].count), st.cmd[i].latency_max_us);
+		}
+	Serial.printf ("      write %5u %4u %6u  %u/%u/%u\n", st.write.count, st.write.fail_count, st.write.bytes,
+		st.write.latency_min_us, (uint32_t)(st.write.latency_sum_us / st.write.count), st.write.latency_max_us);
+	Serial.printf ("0x58: latency histogram from <%uus:", 1 << LCM300_STATS_BIN0_SHIFT);
+	for (i=0; i<LCM300_STATS_BINS; i++)
+		Serial.printf (" %u", st.histogram[i]);
+	Serial.printf ("\n0x58: busy %.1fms, waiting %.1fs, %.3f%% of the time; 0x59: %u NAKs, %u timeouts, %u short reads\n",
+		st.busy_us / 1000.0, st.wait_us / 1000000.0, 100 * supply[0].stats_utilization(), supply_stats[1].nak_count,
+		supply_stats[1].timeout_count, supply_stats[1].short_read_count);
+	Serial.printf ("bus utilization %.3f%%\n", 100 * bus.utilization());
+#endif
+
+	// a second net with no i2c_t3 under it: two supplies sharing one host transport, swept together
+	Systronix_LCM300_host_transport	net2;
+	Systronix_LCM300_sim	net2_sim[2];
+	Systronix_LCM300		net2_supply[2];
+	Systronix_LCM300_bus	net2_bus;
+	for (i=0; i<2; i++)
+		{
+		net2_sim[i].attach (net2, LCM300_BASE_MIN + i);
+		net2_supply[i].setup (LCM300_BASE_MIN + i, net2, (char*)"net2");
+		net2_supply[i].begin (I2C_PINS_29_30);
+		if (SUCCESS == net2_supply[i].init())
+			net2_bus.add (net2_supply[i]);
+		}
+	start = host_clock_get();
+	net2_bus.poll_telemetry ();
+	net2_bus.run ();
+	Serial.printf ("\nnet2: %u supplies, one sweep each: %.1fms, %u transactions\n", net2_bus.count(),
+		(host_clock_get() - start) / 1000.0, net2.transaction_count);
+	for (i=0; i<net2_bus.count(); i++)
+		print_telemetry (*net2_bus.device_get(i));
+
+	// a minute and a bit of statistics on 0x5A while its load steps every 2 seconds; no samples are kept
+	Systronix_LCM300_metrics	metrics;
+	metrics.begin (supply[2]);
+	start = host_clock_get();
+	for (i=0; 33 > i; i++)
+		{
+		sim[2].linear11_set (READ_IOUT_CMD_VAL, 4.0 + (i % 5));
+		while (2000000ULL * (i + 1) > host_clock_get() - start)
+			{
+			bus.poll_telemetry ();
+			metrics.update ();
+			}
+		}
+	const Systronix_LCM300_metrics::summary_t&	sec = metrics.last (Systronix_LCM300_metrics::IOUT, Systronix_LCM300_metrics::SECOND);
+	const Systronix_LCM300_metrics::summary_t&	min = metrics.last (Systronix_LCM300_metrics::IOUT, Systronix_LCM300_metrics::MINUTE);
+	Serial.printf ("\n0x5A: Iout last second: %u samples, mean %.2fA\n", sec.count, sec.mean);
+	Serial.printf ("0x5A: Iout last minute: %u samples, mean %.2fA sd %.2f, min %.2fA at %ums, max %.2fA at %ums, median %.2fA, p95 %.2fA;"
+		" EWMA %.2fA\n", min.count, min.mean, Systronix_LCM300_metrics::stddev (min), min.min, min.min_ms, min.max, min.max_ms,
+		min.quantile[0], min.quantile[1], metrics.ewma (Systronix_LCM300_metrics::IOUT));
+	Serial.printf ("0x5A: Vout this hour so far: %u samples, %.3f - %.3fV; %u bytes of statistics\n",
+		metrics.current (Systronix_LCM300_metrics::VOUT, Systronix_LCM300_metrics::HOUR).count,
+		metrics.current (Systronix_LCM300_metrics::VOUT, Systronix_LCM300_metrics::HOUR).min,
+		metrics.current (Systronix_LCM300_metrics::VOUT, Systronix_LCM300_metrics::HOUR).max, (uint32_t)sizeof(metrics));
+
+	bus.run ();											// the driver sees the end of every transfer in the trace
+	recorder.flush ();
+	if (trace_file)
+		{
+		fclose (trace_file);
+		expect_write (out_path ("lcm300_demo.lcmtrace.expect"));
+		}
+	Serial.printf ("\nWire1 trace: %u transactions in %u bytes, %.1f bytes each\n", recorder.record_count, recorder.byte_count,
+		recorder.record_count ? (float)recorder.byte_count / recorder.record_count : 0.0f);
+
+	Serial.printf ("\n%u checks, %u failed\n", check_count, check_fail_count);
+	return check_fail_count ? 1 : 0;
+	}
@@ -0,0 +1,286 @@
+/** ---------- LCM300 binary log to CSV ------------------------
+
+Converts a Systronix_LCM300_log binary log (see Systronix_LCM300_log.h) to CSV on stdout:
+
+	time_us,address,command,raw,value
+
+time_us is micros() on the logging controller, unwrapped to 64 bits.  value is the raw word decoded: Vout
+commands linear-16 with the supply's exponent from its most recent VOUT_MODE record (empty until there is
+one), linear-11 commands linear-11, fan speed, status and other byte commands as is; see the format column of
+Systronix_LCM300::cmd[].
+
+	lcm300_log2csv [log file]		reads stdin without a file name
+
+Reads in large chunks and never holds more than one chunk, so logs of any size convert at disk speed.  A log
+cut off in the middle of a record (power lost while writing, say) converts up to the last whole record.  A
+damaged byte that leaves the decoder at a reserved tag costs the records up to the next sync.  Both are
+reported on stderr; the exit status is 0 unless the file can't be read or is a different log version.
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		decode by Systronix_LCM300::cmd[].format
+
+--------------------------------**/
+
+#include <stdio.h>
+#include <string.h>
+#include <Systronix_LCM300_log.h>
+
+#define		CHUNK			(1 << 16)
+
+
+static const char*	cmd_name[CMD_ARRAY_SIZE] =					// same order as Systronix_LCM300::cmd[]
+	{
+	"VOUT_MODE", "VOUT_COMMAND", "VOUT_MAX", "READ_EOUT", "READ_VOUT", "READ_IOUT", "READ_TEMPERATURE_2",
+	"READ_FAN_SPEED", "READ_POUT", "MFR_ID", "MFR_MODEL", "MFR_REVISION", "MFR_LOCATION", "MFR_DATE",
+	"MFR_SERIAL", "PMBUS_REVISION", "MFR_VOUT_MIN", "MFR_VOUT_MAX", "MFR_IOUT_MAX", "STATUS_BYTE",
+	"STATUS_WORD", "STATUS_VOUT", "STATUS_IOUT", "STATUS_TEMP", "OPERATION", "WRITE_PROTECT"
+	};
+
+static uint64_t		now_us;										// time of the last record, unwrapped
+static bool			synced;										// now_us is known
+static int8_t		exponent[8];								// VOUT_MODE exponent of each address
+static bool			exponent_valid[8];
+
+static uint64_t		record_count;
+static uint64_t		skipped_bytes;								// lost to damage
+static uint32_t		resync_count;
+
+static char			out[CHUNK * 16];							// CSV waiting to be written
+static size_t		out_len;
+
+
+//---------------------------< P U T _ U I N T >--------------------------------------------------------------
+//
+// Decimal text of n at p; returns the new end.  Hand formatting because snprintf() for the integer columns
+// costs more than all the parsing.
+//
+
+static char* put_uint (char* p, uint64_t n)
+	{
+	char	digits[20];
+	int		count = 0;
+
+	do
+		{
+		digits[count++] = '0' + (n % 10);
+		n /= 10;
+		}
+	while (n);
+
+	while (count)
+		*p++ = digits[--count];
+	return p;
+	}
+
+
+static char* put_hex (char* p, uint32_t n, int width)
+	{
+	static const char	hex[] = "0123456789ABCDEF";
+
+	*p++ = '0';
+	*p++ = 'x';
+	while (width--)
+		*p++ = hex[(n >> (4 * width)) & 0x0F];
+	return p;
+	}
+
+
+//---------------------------< E M I T >----------------------------------------------------------------------
+
+static void emit (uint8_t address, uint8_t cmd_idx, uint16_t raw)
+	{
+	float	value;
+	bool	is_float = true;
+	bool	known = true;
+	char*	p = out + out_len;
+
+	switch (Systronix_LCM300::cmd[cmd_idx].format)
+		{
+		case LCM300_FMT_LINEAR16:
+			known = exponent_valid[address];
+			if (known)
+				Systronix_LCM300::decode_linear16 (&raw, &value, 1, exponent[address]);
+			break;
+		case LCM300_FMT_LINEAR11:
+			Systronix_LCM300::decode_linear11 (&raw, &value, 1);
+			break;
+		default:											// byte, status word, fan speed
+			is_float = false;
+			break;
+		}
+
+	if (VOUT_MODE_CMD == cmd_idx)								// sign extend the 5-bit exponent
+		{
+		exponent[address] = (raw & 0x10) ? (int8_t)(raw | 0xE0) : (int8_t)(raw & 0x1F);
+		exponent_valid[address] = true;
+		}
+
+	p = put_uint (p, now_us);
+	*p++ = ',';
+	p = put_hex (p, LCM300_BASE_MIN + address, 2);
+	*p++ = ',';
+	p = stpcpy (p, cmd_name[cmd_idx]);
+	*p++ = ',';
+	p = put_hex (p, raw, 4);
+	*p++ = ',';
+	if (!is_float)
+		p = put_uint (p, raw);
+	else if (known)
+		p += snprintf (p, 24, "%.6g", value);
+	*p++ = '\n';
+
+	out_len = p - out;
+	if (sizeof(out) - 128 < out_len)
+		{
+		fwrite (out, 1, out_len, stdout);
+		out_len = 0;
+		}
+	}
+
+
+//---------------------------< P A R S E >--------------------------------------------------------------------
+//
+// Decode the whole records in data[0..count).  Returns the number of bytes used; what's left is the start of a
+// record that continues in the next chunk.
+//
+
+static size_t parse (const uint8_t* data, size_t count)
+	{
+	size_t		i = 0;
+	size_t		start;
+	uint8_t		tag;
+	uint8_t		cmd_idx;
+	uint32_t	dt;
+	uint32_t	us;
+	uint16_t	raw;
+	int			shift;
+
+	while (i < count)
+		{
+		start = i;
+		tag = data[i];
+		cmd_idx = tag & 0x1F;
+
+		if (LCM300_LOG_SYNC_TAG == tag)
+			{
+			if (count - i < LCM300_LOG_SYNC_SIZE)
+				return start;
+			if (LCM300_LOG_SYNC_MARK == data[i+1])
+				{
+				us = data[i+2] | (data[i+3] << 8) | (data[i+4] << 16) | ((uint32_t)data[i+5] << 24);
+				if (synced)									// unwrap: the nearest 64-bit time with these low 32 bits
+					now_us += (int32_t)(us - (uint32_t)now_us);
+				else
+					now_us = us;
+				synced = true;
+				i += LCM300_LOG_SYNC_SIZE;
+				continue;
+				}
+			}
+		else if ((CMD_ARRAY_SIZE > cmd_idx) && !(LCM300_LOG_BLOCK_CMDS & CMD_MASK(cmd_idx)))
+			{
+			i++;
+			dt = 0;
+			shift = 0;
+			do											// varint dt
+				{
+				if (i >= count)
+					return start;
+				dt |= (uint32_t)(data[i] & 0x7F) << shift;
+				shift += 7;
+				}
+			while ((data[i++] & 0x80) && (21 > shift));
+
+			if (!(data[i-1] & 0x80))						// well formed; else fall through to resync
+				{
+				if (i + ((LCM300_LOG_BYTE_CMDS & CMD_MASK(cmd_idx)) ? 1 : 2) > count)
+					return start;
+				raw = data[i++];
+				if (!(LCM300_LOG_BYTE_CMDS & CMD_MASK(cmd_idx)))
+					raw |= data[i++] << 8;
+
+				now_us += dt;
+				if (synced)
+					emit (tag >> 5, cmd_idx, raw);
+				record_count++;
+				continue;
+				}
+			}
+
+		// lost: skip to the next sync; times are unknown until then
+		resync_count++;
+		synced = false;
+		for (i = start + 1; i < count; i++)
+			{
+			if ((LCM300_LOG_SYNC_TAG == data[i]) && ((i + 1 == count) || (LCM300_LOG_SYNC_MARK == data[i+1])))
+				break;
+			}
+		skipped_bytes += i - start;
+		}
+	return i;
+	}
+
+
+//---------------------------< M A I N >----------------------------------------------------------------------
+
+int main (int argc, char** argv)
+	{
+	static uint8_t	buf[CHUNK + LCM300_LOG_RECORD_MAX];
+	FILE*	in = stdin;
+	size_t	have = 0;
+	size_t	got;
+	size_t	used;
+
+	if (1 < argc && strcmp (argv[1], "-"))
+		{
+		in = fopen (argv[1], "rb");
+		if (!in)
+			{
+			perror (argv[1]);
+			return 1;
+			}
+		}
+
+	have = fread (buf, 1, LCM300_LOG_HEADER_SIZE, in);
+	if ((LCM300_LOG_HEADER_SIZE == have) && !memcmp (buf, "LCM300", 6))
+		{
+		if (LCM300_LOG_VERSION != buf[6])
+			{
+			fprintf (stderr, "log version %u; this decoder reads version %u\n", buf[6], LCM300_LOG_VERSION);
+			return 1;
+			}
+		have = 0;
+		}
+	else
+		fprintf (stderr, "no log header; decoding anyway\n");
+
+	printf ("time_us,address,command,raw,value\n");
+
+	while (0 < (got = fread (buf + have, 1, CHUNK, in)) || have)
+		{
+		have += got;
+		used = parse (buf, have);
+		if (0 == got)											// end of file with part of a record left over
+			{
+			if (have - used)
+				fprintf (stderr, "log truncated: last %zu bytes are an incomplete record\n", have - used);
+			break;
+			}
+		memmove (buf, buf + used, have - used);
+		have -= used;
+		}
+
+	fwrite (out, 1, out_len, stdout);
+	fprintf (stderr, "%llu records", (unsigned long long)record_count);
+	if (resync_count)
+		fprintf (stderr, "; %u resyncs, %llu bytes skipped", resync_count, (unsigned long long)skipped_bytes);
+	fprintf (stderr, "\n");
+
+	if (stdin != in)
+		fclose (in);
+	return 0;
+	}
@@ -0,0 +1,278 @@
+/** ---------- LCM300 trace replay ------------------------
+
+Feeds a bus trace recorded by Systronix_LCM300_recorder (see Systronix_LCM300_trace.h) back through
+Systronix_LCM300 with no bus and no simulator: every read the driver makes is answered with the bytes the
+supplies really sent, at the recorded times on the virtual clock, as fast as the CPU allows.  A regression test
+for decoding, identity, energy and status handling against captured hardware behavior, and a benchmark of the
+driver's per-transaction cost.
+
+	lcm300_replay [trace file] [repeat]		build/lcm300_demo.lcmtrace, 1 pass by default
+
+The trace drives the driver: each write-no-stop of a command byte becomes command_start() of that command,
+completed with command_poll() (or left, if the recording driver never saw it finish); each write() becomes the
+same write, or probe() when it wrote nothing; each bus reset a transport reset_bus().  The supplies are set up
+fresh for each pass with no communication interval (the trace has the real timing) and are taken as present
+while the trace talks to them.  Prints what the supplies ended up with and one JSON line:
+
+	{"bench":"replay","ops":<transactions>,"ns_per_op":<ns>,"checksum":<x>,"mismatch":<n>,"skipped":<n>}
+
+checksum is a function of the final telemetry, energy and error counts of every supply; it is the same on
+every pass and changes only when the trace or the driver's handling of it does.
+
+When the trace has a <trace file>.expect beside it (lcm300_host_demo writes one with its trace), every pass
+is checked against it: one line for each address 0x58 - 0x5F, in order, with what the recording driver ended
+up with,
+
+	0x<address> <vout> <iout> <pout> <temperature_2> <fan_speed> 0x<status_word> <VOUT read ms> <energy_mws> <intervals> <ambiguous>
+
+floats to 9 significant digits, the VOUT read time in milliseconds of trace time.  Each address whose
+replayed line differs is printed, expected then replayed.  The exit status is 1 when the file can't be read
+or isn't a trace, when any transfer found no record to answer it, or when any supply differs from the
+.expect file.
+
+**/
+
+/** ---------- REVISIONS ----------
+
+2026 Oct 16		start
+2026 Oct 16		address-only probes
+2026 Oct 16		results checked against the .expect file beside the trace
+2026 Oct 16		buffers freed on the error exits too
+
+--------------------------------**/
+
+#include <Arduino.h>
+#include <Systronix_LCM300_replay.h>
+#include <Systronix_LCM300.h>
+#include <chrono>
+
+#define		TRACE_MAX		(64 << 20)							// bytes of trace held in memory
+#define		SUPPLIES		(LCM300_BASE_MAX - LCM300_BASE_MIN + 1)	// one for each possible address
+#define		EXPECT_LINE		128									// bytes in one .expect line
+
+
+//
+// pmbus_write() is protected: the driver's own write paths (vout_set(), operation_set() ...) read first and
+// check what they did; the replay needs the write itself
+//
+
+class replay_supply : public Systronix_LCM300
+	{
+	public:
+		using Systronix_LCM300::pmbus_write;
+	};
+
+static Systronix_LCM300_replay	replay;
+static char		expect[SUPPLIES][EXPECT_LINE];				// .expect lines by address; empty when there is none
+static uint32_t	expect_fail_count;							// supplies that differed from .expect, all passes
+
+
+//---------------------------< N O W _ N S >------------------------------------------------------------------
+//
+// real time, not the virtual clock
+//
+
+static uint64_t now_ns (void)
+	{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+
+//---------------------------< C M D _ I N D E X >------------------------------------------------------------
+//
+// Systronix_LCM300::cmd[] index of a command byte; -1 when the driver doesn't know it
+//
+
+static int cmd_index (uint8_t cmd_byte)
+	{
+	int		i;
+
+	for (i=0; i<CMD_ARRAY_SIZE; i++)
+		if (Systronix_LCM300::cmd[i].cmd_byte == cmd_byte)
+			return i;
+	return -1;
+	}
+
+
+//---------------------------< E X P E C T _ L O A D >--------------------------------------------------------
+//
+// Lines of the .expect file into expect[], newlines removed.  false when there is no such file.
+//
+
+static bool expect_load (const char* name)
+	{
+	FILE*		in = fopen (name, "r");
+	uint8_t		i;
+
+	if (!in)
+		return false;
+	for (i=0; (i<SUPPLIES) && fgets (expect[i], EXPECT_LINE, in); i++)
+		expect[i][strcspn (expect[i], "\r\n")] = '\0';
+	fclose (in);
+	return true;
+	}
+
+
+//---------------------------< E X P E C T _ C H E C K >------------------------------------------------------
+//
+// One supply's replayed results as a .expect line, against the one loaded.  Returns true when they are the same
+// or there is nothing to check against.
+//
+
+static bool expect_check (replay_supply& dev, uint8_t index, bool print)
+	{
+	const Systronix_LCM300::telemetry_t&	t = dev.snapshot();
+	const Systronix_LCM300::energy_t&		e = dev.energy;
+	char		line[EXPECT_LINE];
+	uint32_t	vout_ms = t.read_ms[Systronix_LCM300::TELEM_VOUT];
+
+	if (!expect[index][0])
+		return true;
+
+	if (vout_ms)
+		vout_ms -= replay.start_ms ();					// trace time, as recorded
+	snprintf (line, sizeof(line), "0x%.2X %.9g %.9g %.9g %.9g %u 0x%.4X %u %llu %u %u", dev.base_get(), t.vout, t.iout, t.pout,
+		t.temperature_2, t.fan_speed, t.status_word, vout_ms, (unsigned long long)e.energy_mws, e.intervals, e.ambiguous_count);
+	if (!strcmp (line, expect[index]))
+		return true;
+
+	expect_fail_count++;
+	if (print)
+		Serial.printf ("0x%.2X: differs from .expect\n  expected %s\n  replayed %s\n", dev.base_get(), expect[index], line);
+	return false;
+	}
+
+
+//---------------------------< P A S S >----------------------------------------------------------------------
+//
+// The whole trace once through fresh supplies.  Returns the transactions answered; checksum of the results.
+//
+
+static uint32_t pass (replay_supply* supply, double& checksum, bool print)
+	{
+	lcm300_trace_record_t	rec;
+	replay_supply*	dev;
+	uint32_t	used;
+	uint32_t	start_count = replay.match_count;
+	uint16_t	value;
+	uint8_t		count;
+	int			cmd_idx;
+	uint8_t		i;
+
+	for (i=0; i<SUPPLIES; i++)
+		{
+		supply[i].setup (LCM300_BASE_MIN + i, replay, (char*)"replay");
+		supply[i].interval_set (0);
+		}
+	replay.rewind ();
+
+	while (replay.peek (rec))
+		{
+		used = replay.match_count + replay.skip_count;
+		dev = ((LCM300_BASE_MIN <= rec.address) && (LCM300_BASE_MAX >= rec.address)) ? &supply[rec.address - LCM300_BASE_MIN] : NULL;
+
+		if (LCM300_TRACE_RESET == rec.kind)
+			replay.reset_bus ();							// of the bus, not of whichever supply asked for it
+		else if (dev && (LCM300_TRACE_WRITE_NOSTOP == rec.kind) && rec.count && (0 <= (cmd_idx = cmd_index (rec.data[0]))))
+			{
+			dev->error.exists = true;
+			if (SUCCESS == dev->command_start (cmd_idx))
+				while ((LCM300_PENDING == dev->command_poll()) && !replay.stalled());
+			}
+		else if (dev && (LCM300_TRACE_WRITE == rec.kind) && !rec.count)
+			dev->probe ();
+		else if (dev && (LCM300_TRACE_WRITE == rec.kind))
+			{
+			count = rec.count - 1;							// command byte, data and maybe PEC; the supplies here use no PEC
+			if (2 < count)
+				count = 2;
+			value = (1 < rec.count ? rec.data[1] : 0) | (2 < rec.count ? rec.data[2] << 8 : 0);
+			dev->error.exists = true;
+			dev->pmbus_write (rec.data[0], value, count);
+			}
+
+		if (used == replay.match_count + replay.skip_count)	// nothing the driver would start, or it started something else
+			replay.skip ();
+		}
+
+	checksum = 0;
+	for (i=0; i<SUPPLIES; i++)
+		{
+		const Systronix_LCM300::telemetry_t&	t = supply[i].snapshot();
+		const Systronix_LCM300::energy_t&		e = supply[i].energy;
+
+		checksum += t.vout + t.iout + t.pout + t.temperature_2 + t.fan_speed + t.status_word + e.energy_mws / 1000.0 +
+			e.intervals + e.ambiguous_count + supply[i].error.total_error_count;
+		expect_check (supply[i], i, print);
+		if (!print || (!t.read_ms[Systronix_LCM300::TELEM_VOUT] && !supply[i].error.total_error_count))
+			continue;
+
+		Serial.printf ("0x%.2X: %.2fV %.2fA %.1fW %.1fC %urpm status 0x%.4X; %s %s; %.3fWh over %u intervals, %u ambiguous;"
+			" %u errors\n", supply[i].base_get(), t.vout, t.iout, t.pout, t.temperature_2, t.fan_speed, t.status_word,
+			supply[i].identity.mfr_id, supply[i].identity.mfr_model, e.energy_mws / 3600000.0, e.intervals, e.ambiguous_count,
+			(uint32_t)supply[i].error.total_error_count);
+		}
+	return replay.match_count - start_count;
+	}
+
+
+//---------------------------< M A I N >----------------------------------------------------------------------
+
+int main (int argc, char** argv)
+	{
+	const char*	name = (1 < argc) ? argv[1] : "build/lcm300_demo.lcmtrace";
+	uint32_t	repeat = (2 < argc) ? atoi (argv[2]) : 1;
+	FILE*		in = fopen (name, "rb");
+	uint8_t*	trace = new uint8_t[TRACE_MAX];
+	size_t		size;
+	replay_supply*	supply = new replay_supply[SUPPLIES]();	// () zeroes error_t, which has no initializers
+	double		checksum = 0;
+	char		expect_name[256];
+	uint64_t	ops = 0;
+	uint64_t	start;
+	uint64_t	ns = 0;
+	uint32_t	i;
+
+	if (!in)
+		{
+		fprintf (stderr, "lcm300_replay: can't open %s\n", name);
+		delete[] supply;
+		delete[] trace;
+		return 1;
+		}
+	size = fread (trace, 1, TRACE_MAX, in);
+	fclose (in);
+	if (!replay.load (trace, size))
+		{
+		fprintf (stderr, "lcm300_replay: %s is not a version %u trace\n", name, LCM300_TRACE_VERSION);
+		delete[] supply;
+		delete[] trace;
+		return 1;
+		}
+	snprintf (expect_name, sizeof(expect_name), "%s.expect", name);
+	if (!expect_load (expect_name))
+		fprintf (stderr, "lcm300_replay: no %s; results not checked\n", expect_name);
+
+	for (i=0; i<repeat; i++)
+		{
+		if (i)												// fresh supplies for every pass
+			{
+			delete[] supply;
+			supply = new replay_supply[SUPPLIES]();
+			}
+		start = now_ns();
+		ops += pass (supply, checksum, 0 == i);
+		ns += now_ns() - start;
+		}
+
+	if (replay.damaged)
+		fprintf (stderr, "lcm300_replay: last %u bytes of %s are not a whole record\n", replay.damaged, name);
+	Serial.printf ("%s: %u bytes, %u passes: %u answered, %u mismatched, %u records skipped; %u supply results differ from .expect\n",
+		name, (uint32_t)size, repeat, replay.match_count, replay.mismatch_count, replay.skip_count, expect_fail_count);
+	printf ("{\"bench\":\"replay\",\"ops\":%llu,\"ns_per_op\":%.3f,\"checksum\":%.6g,\"mismatch\":%u,\"skipped\":%u}\n",
+		(unsigned long long)ops, ops ? (double)ns / ops : 0.0, checksum, replay.mismatch_count, replay.skip_count);
+
+	delete[] supply;
+	delete[] trace;
+	return (replay.mismatch_count || expect_fail_count) ? 1 : 0;
+	}